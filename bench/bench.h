@@ -0,0 +1,81 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_BENCH_H
+#define TEST_BENCODE_BENCH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <Writer.h>
+
+//shared helpers of the benchmarks:best-of-N timing,a global allocation counter and a
+//generator for torrent-like test messages.include from exactly one translation unit,
+//it replaces operator new
+namespace bench {
+    inline std::atomic<size_t> allocations{0};
+
+    //fastest of runs calls in milliseconds,the minimum is the least noisy figure
+    template<class Fn>
+    double best_ms(int runs, Fn &&fn) {
+        double best = 1e300;
+        for (int i = 0; i < runs; i++) {
+            auto t = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - t;
+            if (d.count() < best) best = d.count();
+        }
+        return best;
+    }
+
+    //heap allocations made by one call of fn
+    template<class Fn>
+    size_t count_allocations(Fn &&fn) {
+        auto before = allocations.load(std::memory_order_relaxed);
+        fn();
+        return allocations.load(std::memory_order_relaxed) - before;
+    }
+
+    //a .torrent shaped message:an info dict with a list of files and a pieces string
+    inline std::string torrent(std::mt19937 &rng) {
+        bencode::Writer w;
+        w.begin_dict().key("announce").value("http://tracker.example.org:6969/announce");
+        w.key("info").begin_dict().key("files").begin_list();
+        auto files = 1 + rng() % 30;
+        for (size_t i = 0; i < files; i++) {
+            w.begin_dict().key("length").value(int64_t(rng() % 100000000));
+            w.key("path").begin_list().value("dir").value("file" + std::to_string(i) + ".bin").end();
+            w.end();
+        }
+        w.end().key("name").value("example");
+        w.key("piece length").value(int64_t(262144));
+        w.key("pieces").value(std::string(20 * (1 + rng() % 50), 'x'));
+        w.end().end();
+        return w.take();
+    }
+
+    inline std::vector<std::string> torrents(size_t n, unsigned seed = 7) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> ret;
+        for (size_t i = 0; i < n; i++) ret.push_back(torrent(rng));
+        return ret;
+    }
+}
+
+void *operator new(size_t n) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+#endif //TEST_BENCODE_BENCH_H
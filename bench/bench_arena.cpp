@@ -0,0 +1,46 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+//Document (nodes in one arena) against BObject (a shared_ptr per node) on the same messages
+#include "bench.h"
+#include <bencode.h>
+
+using namespace bencode;
+
+int main() {
+    auto msgs = bench::torrents(2000);
+    size_t bytes = 0;
+    for (auto &&m: msgs) bytes += m.size();
+    size_t nodes = 0;
+
+    auto per_node = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            auto obj = BObject::Parse(std::string_view(m), &e);
+            nodes += obj != nullptr;
+        }
+    });
+    auto arena = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            auto doc = Document::Parse(m, &e);
+            nodes += !doc.buffer().empty();
+        }
+    });
+    auto per_node_allocs = bench::count_allocations([&] {
+        Error e;
+        auto obj = BObject::Parse(std::string_view(msgs[0]), &e);
+    });
+    auto arena_allocs = bench::count_allocations([&] {
+        Error e;
+        auto doc = Document::Parse(msgs[0], &e);
+    });
+
+    std::printf("%zu messages,%zu bytes\n", msgs.size(), bytes);
+    std::printf("BObject::Parse  (shared_ptr per node) %8.2f ms %6zu allocations for the first message\n",
+                per_node, per_node_allocs);
+    std::printf("Document::Parse (arena)               %8.2f ms %6zu allocations for the first message\n",
+                arena, arena_allocs);
+    return nodes == 0;
+}
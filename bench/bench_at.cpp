@@ -0,0 +1,69 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+//reading back appended values:at(i).value() and values<T>() against a walk of the LIST by hand,
+//a plain vector,and the std::function wrapper at() used to return
+#include "bench.h"
+#include <bencode.h>
+#include <functional>
+
+using namespace bencode;
+
+namespace {
+    //what at<T>(i) returned before:a std::function holding a shared_ptr to the element
+    struct FunctionValue {
+        std::function<int64_t()> value;
+    };
+
+    FunctionValue functionAt(BObject::LIST &list, size_t i) {
+        auto node = list.at(i);
+        return {[node] { return int64_t(*node); }};
+    }
+}
+
+int main() {
+    const size_t n = 100000;
+    auto root = std::make_shared<BObject>(BObject::DICT{});
+    Bencode b(root);
+    std::vector<int64_t> plain;
+    for (size_t i = 0; i < n; i++) {
+        b.append(int64_t(i));
+        plain.push_back(int64_t(i));
+    }
+    auto &list = *root->Dict()->find("LIST")->second->List();
+    int64_t total = 0;
+
+    auto function = bench::best_ms(5, [&] {
+        for (size_t i = 0; i < n; i++) total += functionAt(list, i).value();
+    });
+    auto at = bench::best_ms(5, [&] {
+        for (size_t i = 0; i < n; i++) total += b.at<int64_t>(i).value();
+    });
+    auto values = bench::best_ms(5, [&] {
+        for (int64_t v: b.values<int64_t>()) total += v;
+    });
+    auto walk = bench::best_ms(5, [&] {
+        for (auto &&node: list) total += *node->Int();
+    });
+    auto vec = bench::best_ms(5, [&] {
+        for (auto v: plain) total += v;
+    });
+    auto function_allocs = bench::count_allocations([&] {
+        for (size_t i = 0; i < n; i++) total += functionAt(list, i).value();
+    });
+    auto at_allocs = bench::count_allocations([&] {
+        for (size_t i = 0; i < n; i++) total += b.at<int64_t>(i).value();
+    });
+    auto values_allocs = bench::count_allocations([&] {
+        for (int64_t v: b.values<int64_t>()) total += v;
+    });
+
+    std::printf("%zu appended integers\n", n);
+    std::printf("std::function at(i)   %7.2f ms %7zu allocations\n", function, function_allocs);
+    std::printf("at<T>(i).value()      %7.2f ms %7zu allocations\n", at, at_allocs);
+    std::printf("values<T>()           %7.2f ms %7zu allocations\n", values, values_allocs);
+    std::printf("LIST walk             %7.2f ms\n", walk);
+    std::printf("std::vector<int64_t>  %7.2f ms\n", vec);
+    return total == 0;
+}
@@ -0,0 +1,84 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+//the three __DICT__ choices side by side on the same keys:building a dict from keys in ascending
+//order (as parsing canonical input does),string_view lookups and an in-order walk
+#include "bench.h"
+#include <bencode.h>
+#include <FlatMap.h>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+using namespace bencode;
+
+namespace {
+    using Value = std::shared_ptr<BObject>;
+    using Keys = std::vector<std::vector<std::string>>;
+
+    const std::vector<std::string> Vocabulary = {
+            "announce", "announce-list", "comment", "created by", "creation date", "encoding", "files",
+            "info", "length", "md5sum", "name", "path", "piece length", "pieces", "private", "source",
+            "url-list", "ip", "peer id", "port", "uploaded", "downloaded", "left", "event", "numwant",
+    };
+
+    //n sorted key sets of 2-15 distinct keys each
+    Keys keySets(size_t n) {
+        std::mt19937 rng(7);
+        Keys ret(n);
+        for (auto &&keys: ret) {
+            auto pool = Vocabulary;
+            std::shuffle(pool.begin(), pool.end(), rng);
+            pool.resize(2 + rng() % 14);
+            std::sort(pool.begin(), pool.end());
+            keys = std::move(pool);
+        }
+        return ret;
+    }
+
+    template<class Dict>
+    void run(const char *name, const Keys &sets) {
+        auto value = std::make_shared<BObject>(int64_t(1));
+        std::vector<Dict> dicts;
+        size_t found = 0;
+
+        auto build = bench::best_ms(5, [&] {
+            dicts.clear();
+            dicts.resize(sets.size());
+            for (size_t i = 0; i < sets.size(); i++) {
+                for (auto &&key: sets[i]) dicts[i].emplace(key, value);
+            }
+        });
+        auto allocs = bench::count_allocations([&] {
+            Dict dict;
+            for (auto &&key: sets[0]) dict.emplace(key, value);
+        });
+        //three lookups per dict:the first key,the last key and one that is usually missing
+        auto lookup = bench::best_ms(5, [&] {
+            for (size_t i = 0; i < sets.size(); i++) {
+                auto &dict = dicts[i];
+                found += dict.find(std::string_view(sets[i].front())) != dict.end();
+                found += dict.find(std::string_view(sets[i].back())) != dict.end();
+                found += dict.find(std::string_view("length")) != dict.end();
+            }
+        });
+        auto walk = bench::best_ms(5, [&] {
+            for (auto &&dict: dicts) {
+                for (auto &&[k, v]: dict) found += k.size();
+            }
+        });
+
+        std::printf("%-30s build %7.2f ms (%2zu allocations for %2zu keys)  %zuk lookups %6.2f ms  walk %6.2f ms\n",
+                    name, build, allocs, sets[0].size(), sets.size() * 3 / 1000, lookup, walk);
+        if (found == 0) std::printf("nothing found\n");
+    }
+}
+
+int main() {
+    auto sets = keySets(50000);
+    run<std::map<std::string, Value, std::less<>>>("std::map", sets);
+    run<std::unordered_map<std::string, Value, KeyHash, std::equal_to<>>>("std::unordered_map (U_DICT)", sets);
+    run<FlatMap<std::string, Value>>("bencode::FlatMap (F_DICT)", sets);
+    return 0;
+}
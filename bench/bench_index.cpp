@@ -0,0 +1,58 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+//two-stage parse (SIMD structural index,then a walk of the index) against the scalar
+//one-pass parsers building the same result
+#include "bench.h"
+#include <bencode.h>
+
+using namespace bencode;
+
+int main() {
+    auto msgs = bench::torrents(2000);
+    size_t bytes = 0;
+    for (auto &&m: msgs) bytes += m.size();
+    size_t ok = 0;
+
+    auto scalar_object = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            ok += BObject::Parse(std::string_view(m), &e) != nullptr;
+        }
+    });
+    auto index_object = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            auto index = StructuralIndex::Build(m, &e);
+            ok += index.ToObject(&e) != nullptr;
+        }
+    });
+    auto scalar_tape = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            ok += !Tape::Parse(m, &e).empty();
+        }
+    });
+    auto index_tape = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            auto index = StructuralIndex::Build(m, &e);
+            ok += !index.ToTape(&e).empty();
+        }
+    });
+    auto stage1 = bench::best_ms(5, [&] {
+        for (auto &&m: msgs) {
+            Error e;
+            ok += StructuralIndex::Build(m, &e).positions().size();
+        }
+    });
+
+    std::printf("%zu messages,%zu bytes,stage 1 uses %s\n", msgs.size(), bytes, StructuralIndex::Implementation());
+    std::printf("BObject::Parse                   %8.2f ms\n", scalar_object);
+    std::printf("StructuralIndex + ToObject       %8.2f ms\n", index_object);
+    std::printf("Tape::Parse                      %8.2f ms\n", scalar_tape);
+    std::printf("StructuralIndex + ToTape         %8.2f ms\n", index_tape);
+    std::printf("StructuralIndex::Build (stage 1) %8.2f ms\n", stage1);
+    return ok == 0;
+}
@@ -0,0 +1,58 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+//BObject::Parse(std::string_view) on its own loop against the same Builder driven by Reader::Parse,
+//which is what the tree path used before.runs are interleaved so both see the same machine state
+#include "bench.h"
+#include <bencode.h>
+
+using namespace bencode;
+
+namespace {
+    //a tracker announce reply,the small message most callers parse
+    std::vector<std::string> replies(size_t n) {
+        std::vector<std::string> ret;
+        for (size_t i = 0; i < n; i++) {
+            Writer w;
+            w.begin_dict().key("complete").value(int64_t(i % 50)).key("incomplete").value(int64_t(i % 7));
+            w.key("interval").value(int64_t(1800)).key("peers").begin_list();
+            for (size_t p = 0; p < 3; p++) {
+                w.begin_dict().key("ip").value("10.0.0." + std::to_string(p)).key("port").value(int64_t(6881 + p));
+                w.end();
+            }
+            w.end().end();
+            ret.push_back(w.take());
+        }
+        return ret;
+    }
+
+    void run(const char *name, const std::vector<std::string> &msgs) {
+        size_t ok = 0;
+        double loop = 1e300, reader = 1e300;
+        for (int i = 0; i < 20; i++) {
+            loop = std::min(loop, bench::best_ms(1, [&] {
+                for (auto &&m: msgs) {
+                    Error e;
+                    ok += BObject::Parse(std::string_view(m), &e) != nullptr;
+                }
+            }));
+            reader = std::min(reader, bench::best_ms(1, [&] {
+                for (auto &&m: msgs) {
+                    Error e;
+                    BObject::Builder builder;
+                    ok += Reader::Parse(m, builder, &e) && builder.root;
+                }
+            }));
+        }
+        std::printf("%-10s BObject::Parse %7.0f ns/message   Reader + Builder %7.0f ns/message\n", name,
+                    loop * 1e6 / msgs.size(), reader * 1e6 / msgs.size());
+        if (ok == 0) std::printf("nothing parsed\n");
+    }
+}
+
+int main() {
+    run("replies", replies(20000));
+    run("torrents", bench::torrents(2000));
+    return 0;
+}
@@ -0,0 +1,38 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_ALLOC_COUNT_H
+#define TEST_BENCODE_ALLOC_COUNT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+//counts heap allocations for the checks that must not allocate.include from exactly one
+//translation unit,it replaces the global operator new
+namespace bencode::check {
+    //per thread,so a count taken on the main thread ignores workers
+    inline thread_local size_t allocations = 0;
+    //while set,an allocation on any thread but spared throws std::bad_alloc
+    inline std::atomic<bool> failOthers{false};
+    inline std::thread::id spared;
+}
+
+void *operator new(size_t n) {
+    if (bencode::check::failOthers.load(std::memory_order_acquire) &&
+        std::this_thread::get_id() != bencode::check::spared) {
+        throw std::bad_alloc();
+    }
+    bencode::check::allocations++;
+    if (auto p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+#endif //TEST_BENCODE_ALLOC_COUNT_H
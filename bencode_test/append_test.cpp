@@ -0,0 +1,122 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "alloc_count.h"
+#include "check.h"
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bencode;
+
+struct Point {
+    int64_t x = 0;
+    int64_t y = 0;
+};
+
+void to_bencode(Bencode &b, const Point &p) {
+    b["x"] = p.x;
+    b["y"] = p.y;
+}
+
+void from_bencode(Bencode &b, Point &p) {
+    b["x"].get_to(p.x);
+    b["y"].get_to(p.y);
+}
+
+namespace {
+    //at() and values() read back what append() wrote,in order
+    void readBack() {
+        Bencode b;
+        b.append(1).append(int64_t(-2)).append(3);
+        CHECK(b.at<int>(0).value() == 1);
+        CHECK(b.at<int64_t>(1).value() == -2);
+        std::vector<int64_t> all;
+        for (int64_t v: b.values<int64_t>()) all.push_back(v);
+        CHECK(all == std::vector<int64_t>({1, -2, 3}));
+        CHECK(b.values<int>().size() == 3 && !b.values<int>().empty());
+
+        Bencode strs;
+        strs.append("abc").append(std::string("def"));
+        CHECK(strs.at<std::string>(1).value() == "def");
+        std::vector<std::string> got(strs.values<std::string>().begin(), strs.values<std::string>().end());
+        CHECK(got == std::vector<std::string>({"abc", "def"}));
+
+        Bencode nested;
+        nested.append(std::vector<int>{1, 2}).append(Point{3, 4});
+        CHECK(nested.at<BObject::LIST>(0).value().size() == 2);
+        auto p = nested.at<Point>(1).value();
+        CHECK(p.x == 3 && p.y == 4);
+
+        //a handle stays usable while its element is in the LIST
+        auto first = b.at<int64_t>(0);
+        b.append(4);
+        CHECK(first.value() == 1);
+        auto it = b.values<int64_t>().begin();
+        CHECK(*it++ == 1 && *it == -2);
+        CHECK(std::distance(b.values<int64_t>().begin(), b.values<int64_t>().end()) == 4);
+    }
+
+    //reading appended values allocates nothing
+    void noAllocation() {
+        Bencode b;
+        for (int i = 0; i < 1000; i++) b.append(i);
+        int64_t total = 0;
+        auto before = check::allocations;
+        for (size_t i = 0; i < 1000; i++) total += b.at<int64_t>(i).value();
+        for (int64_t v: b.values<int64_t>()) total += v;
+        CHECK(check::allocations == before);
+        CHECK(total == 2 * 999 * 1000 / 2);
+    }
+
+    //a missing LIST or index throws,as before
+    void errors() {
+        Bencode empty;
+        bool threw = false;
+        try {
+            empty.at<int>(0);
+        } catch (std::runtime_error &) {
+            threw = true;
+        }
+        CHECK(threw);
+        Bencode one;
+        one.append(1);
+        threw = false;
+        try {
+            one.at<int>(1);
+        } catch (std::out_of_range &) {
+            threw = true;
+        }
+        CHECK(threw);
+        threw = false;
+        try {
+            one.at<std::string>(0).value();
+        } catch (std::runtime_error &) {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    //a parsed dict holding a LIST is read the same way
+    void fromParsed() {
+        Error error;
+        auto root = BObject::Parse(std::string_view("d4:LISTli5ei6eee"), &error);
+        CHECK(root != nullptr);
+        if (!root) return;
+        Bencode b(root);
+        CHECK(b.at<int>(1).value() == 6);
+        int64_t sum = 0;
+        for (int64_t v: b.values<int64_t>()) sum += v;
+        CHECK(sum == 11);
+    }
+}
+
+int main() {
+    readBack();
+    noAllocation();
+    errors();
+    fromParsed();
+    return bencode::check::report("append_test");
+}
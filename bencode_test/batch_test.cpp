@@ -0,0 +1,130 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "alloc_count.h"
+#include "check.h"
+#include <new>
+#include <sstream>
+#include <vector>
+
+using namespace bencode;
+
+namespace {
+    //valid and broken messages interleaved,each result must match its own Document::Parse
+    std::vector<std::string> messages(size_t n) {
+        const std::vector<std::string> shapes = {
+                "d1:ad2:id20:abcdefghij0123456789e1:q4:ping1:t2:aa1:y1:qe",
+                "d1:rd2:id20:mnopqrstuvwxyz012345e1:t2:aa1:y1:re",
+                "li1ei2ei3ee",
+                "0:",
+                "i03e",
+                "d1:a",
+                "x",
+        };
+        std::vector<std::string> ret;
+        for (size_t i = 0; i < n; i++) {
+            ret.push_back(shapes[i % shapes.size()]);
+            if (i % shapes.size() == 2) ret.back() = "li" + std::to_string(i) + "ee";
+        }
+        return ret;
+    }
+
+    std::string write(BView &view) {
+        std::ostringstream os;
+        view.Bencode(os);
+        return os.str();
+    }
+
+    void matches(std::span<BatchResult> results, const std::vector<std::string> &msgs) {
+        CHECK(results.size() == msgs.size());
+        for (size_t i = 0; i < results.size() && i < msgs.size(); i++) {
+            Error error;
+            size_t used = 0;
+            auto doc = Document::Parse(msgs[i], &error, &used);
+            CHECK(results[i].error == error);
+            CHECK(results[i].consumed == used);
+            if (error == Error::NoError) {
+                CHECK(write(results[i].root) == msgs[i]);
+            }
+        }
+    }
+
+    std::vector<std::string_view> views(const std::vector<std::string> &msgs) {
+        return {msgs.begin(), msgs.end()};
+    }
+
+    void singleThread() {
+        auto msgs = messages(100);
+        auto in = views(msgs);
+        matches(parse_batch(in), msgs);
+
+        ParseContext ctx;
+        std::vector<BatchResult> out(in.size());
+        for (int round = 0; round < 3; round++) {//the context is rewound,not rebuilt
+            ctx.parse(in, out.data());
+            matches(out, msgs);
+        }
+    }
+
+    void threads() {
+        auto msgs = messages(1000);
+        auto in = views(msgs);
+        BatchParser parser(4);
+        for (int round = 0; round < 3; round++) {
+            matches(parser.parse_batch(in), msgs);
+        }
+        //a small batch stays on the calling thread,an empty one is fine too
+        auto few = messages(10);
+        auto fewIn = views(few);
+        matches(parser.parse_batch(fewIn), few);
+        CHECK(parser.parse_batch({}).empty());
+    }
+
+    //a parse failing on a worker is rethrown by parse_batch(),and the parser stays usable
+    void workerFailure() {
+        auto msgs = messages(1000);
+        auto in = views(msgs);
+        BatchParser parser(4);
+        check::spared = std::this_thread::get_id();
+        check::failOthers = true;
+        bool threw = false;
+        try {
+            parser.parse_batch(in);
+        } catch (std::bad_alloc &) {
+            threw = true;
+        }
+        check::failOthers = false;
+        CHECK(threw);
+        matches(parser.parse_batch(in), msgs);
+        //a batch too small for every worker leaves the rest idle,and is still complete
+        auto some = messages(200);
+        auto someIn = views(some);
+        BatchParser wide(8);
+        for (int round = 0; round < 3; round++) {
+            matches(wide.parse_batch(someIn), some);
+            matches(wide.parse_batch(in), msgs);
+        }
+    }
+
+    void limits() {
+        ParseLimits shallow;
+        shallow.max_depth = 1;
+        std::vector<std::string_view> in = {"li1ee", "lli1eee"};
+        auto results = parse_batch(in, shallow);
+        CHECK(results.size() == 2);
+        CHECK(results[0].error == Error::NoError);
+        CHECK(results[1].error == Error::ErrDep);
+        BatchParser parser(2, shallow);
+        auto again = parser.parse_batch(in);
+        CHECK(again[1].error == Error::ErrDep);
+    }
+}
+
+int main() {
+    singleThread();
+    threads();
+    workerFailure();
+    limits();
+    return bencode::check::report("batch_test");
+}
@@ -0,0 +1,201 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "alloc_count.h"
+#include "check.h"
+#include <sstream>
+
+using namespace bencode;
+
+namespace {
+    std::shared_ptr<BObject> parse(const std::string &text) {
+        Error error;
+        return BObject::Parse(std::string_view(text), &error);
+    }
+
+    std::string write(BObject &obj) {
+        std::ostringstream os;
+        obj.Bencode(os);
+        return os.str();
+    }
+
+    //the encoding parses back to the tree text describes,dict order aside
+    bool encodes(BObject &obj, const std::string &text) {
+        auto got = parse(write(obj));
+        auto want = parse(text);
+        return got && want && check::same(*got, *want);
+    }
+
+    //cached encodings stay equal to a fresh walk through every kind of change
+    void dirtyTracking() {
+        auto obj = parse("d5:filesld6:lengthi1eed6:lengthi2eee4:name3:abce");
+        if (!obj) {
+            CHECK(obj != nullptr);
+            return;
+        }
+        obj->cache_encoding();
+        auto text = write(*obj);
+        BObject::reset_cache_stats();
+        CHECK(write(*obj) == text);
+        CHECK(BObject::cache_stats().hits == 1);
+
+        auto files = obj->Dict()->find(std::string_view("files"))->second;
+        auto second = (*files->List())[1];
+        //a container assigned to marks itself and its ancestors
+        *second = BObject::DICT{};
+        CHECK(encodes(*obj, "d5:filesld6:lengthi1eedee4:name3:abce"));
+        //so does a scalar,through the link to its container
+        auto length = (*files->List())[0]->Dict()->find(std::string_view("length"))->second;
+        *length = int64_t(7);
+        CHECK(encodes(*obj, "d5:filesld6:lengthi7eedee4:name3:abce"));
+        files->List()->pop_back();
+        files->mark_dirty();
+        CHECK(encodes(*obj, "d5:filesld6:lengthi7eee4:name3:abce"));
+        BObject::reset_cache_stats();
+        CHECK(encodes(*obj, "d5:filesld6:lengthi7eee4:name3:abce"));
+        CHECK(BObject::cache_stats().hits == 1 && BObject::cache_stats().misses == 0);
+
+        //a node shared by two cached containers dirties both
+        auto shared = std::make_shared<BObject>(BObject::LIST{});
+        BObject::LIST pair{shared, shared};
+        BObject two(std::move(pair));
+        two.cache_encoding();
+        CHECK(write(two) == "llelee");
+        shared->List()->push_back(std::make_shared<BObject>(int64_t(1)));
+        shared->mark_dirty();
+        CHECK(write(two) == "lli1eeli1eee");
+    }
+
+    //leaves get no cache of their own,so caching a wide list costs a handful of allocations
+    void scalarLeaves() {
+        BObject::LIST items;
+        for (int i = 0; i < 1000; i++) items.push_back(std::make_shared<BObject>(int64_t(i)));
+        BObject list(std::move(items));
+        list.cache_encoding();
+        std::string out;
+        out.reserve(8000);
+        auto before = check::allocations;
+        list.encode_to(out);
+        CHECK(check::allocations - before < 50);
+    }
+
+    //changing the same path over and over neither grows the links nor allocates once warm
+    void repeatedEncodes() {
+        auto obj = parse("d1:ald1:bi1eee1:ci2ee");
+        if (!obj) return;
+        obj->cache_encoding();
+        auto inner = (*obj->Dict()->find(std::string_view("a"))->second->List())[0];
+        std::string out;
+        out.reserve(64);
+        auto cycle = [&] {
+            *inner->Dict()->find(std::string_view("b"))->second = int64_t(1);
+            out.clear();
+            obj->encode_to(out);
+        };
+        for (int i = 0; i < 10; i++) cycle();
+        auto before = check::allocations;
+        cycle();
+        auto one = check::allocations - before;
+        before = check::allocations;
+        for (int i = 0; i < 1000; i++) cycle();
+        CHECK(check::allocations - before == 1000 * one);
+        CHECK(out == write(*obj) && encodes(*obj, "d1:ald1:bi1eee1:ci2ee"));
+    }
+
+    //turning the cache off drops the stored bytes,encoding walks the tree again
+    void turnedOff() {
+        auto obj = parse("d1:ald1:bi1eee1:ci2ee");
+        if (!obj) return;
+        obj->cache_encoding();
+        write(*obj);
+        obj->cache_encoding(false);
+        BObject::reset_cache_stats();
+        CHECK(encodes(*obj, "d1:ald1:bi1eee1:ci2ee"));
+        CHECK(BObject::cache_stats().hits == 0 && BObject::cache_stats().misses == 0);
+        auto c = obj->Dict()->find(std::string_view("c"))->second;
+        *c = int64_t(3);
+        CHECK(encodes(*obj, "d1:ald1:bi1eee1:ci3ee"));
+        //and on again
+        obj->cache_encoding();
+        write(*obj);
+        *c = int64_t(4);
+        CHECK(encodes(*obj, "d1:ald1:bi1eee1:ci4ee"));
+    }
+
+    //assigning to a string or integer dirties the containers above it,whatever it becomes
+    void leafAssignments() {
+        auto obj = parse("d1:ad1:xi1eee");
+        if (!obj) return;
+        obj->cache_encoding();
+        CHECK(write(*obj) == "d1:ad1:xi1eee");
+        auto &leaf = *obj->Dict()->find(std::string_view("a"))->second->Dict()->find(std::string_view("x"))->second;
+        leaf = int64_t(2);
+        CHECK(write(*obj) == "d1:ad1:xi2eee");
+        leaf = std::string("s");
+        CHECK(write(*obj) == "d1:ad1:x1:see");
+        //a scalar that becomes a container,then changes as one
+        leaf = BObject::LIST{};
+        CHECK(write(*obj) == "d1:ad1:xleee");
+        leaf.List()->push_back(std::make_shared<BObject>(int64_t(5)));
+        leaf.mark_dirty();
+        CHECK(write(*obj) == "d1:ad1:xli5eeee");
+        auto &item = *(*leaf.List())[0];
+        item = int64_t(6);
+        CHECK(write(*obj) == "d1:ad1:xli6eeee");
+        //and back to a scalar
+        leaf = int64_t(3);
+        CHECK(write(*obj) == "d1:ad1:xi3eee");
+        leaf = int64_t(4);
+        CHECK(write(*obj) == "d1:ad1:xi4eee");
+        //a change through Str()/Int() is recorded with mark_dirty() on the leaf itself
+        *leaf.Int() = 8;
+        leaf.mark_dirty();
+        CHECK(write(*obj) == "d1:ad1:xi8eee");
+
+        //a leaf held by two cached containers dirties both
+        auto shared = std::make_shared<BObject>(int64_t(1));
+        BObject a(BObject::LIST{shared}), b(BObject::LIST{shared});
+        a.cache_encoding();
+        b.cache_encoding();
+        CHECK(write(a) == "li1ee" && write(b) == "li1ee");
+        *shared = int64_t(2);
+        CHECK(write(a) == "li2ee" && write(b) == "li2ee");
+
+        //a leaf outliving its container can still be assigned to
+        auto kept = std::make_shared<BObject>(int64_t(1));
+        {
+            BObject list(BObject::LIST{kept});
+            list.cache_encoding();
+            CHECK(write(list) == "li1ee");
+        }
+        *kept = int64_t(2);
+        BObject other(BObject::LIST{kept});
+        other.cache_encoding();
+        CHECK(write(other) == "li2ee");
+        *kept = int64_t(3);
+        CHECK(write(other) == "li3ee");
+    }
+
+    //Bencode::take moves a string out and dirties the dict holding it
+    void takeMarksContainer() {
+        auto obj = parse("d4:name3:abc4:sizei1ee");
+        if (!obj) return;
+        Bencode b(obj);
+        b.cache_encoding();
+        std::ostringstream first;
+        first << b;
+        CHECK(b["name"].take<std::string>() == "abc");
+        CHECK(encodes(*obj, "d4:name0:4:sizei1ee"));
+    }
+}
+
+int main() {
+    dirtyTracking();
+    scalarLeaves();
+    repeatedEncodes();
+    turnedOff();
+    leafAssignments();
+    takeMarksContainer();
+    return bencode::check::report("cache_test");
+}
@@ -0,0 +1,78 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_CHECK_H
+#define TEST_BENCODE_CHECK_H
+
+#include <bencode.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+//minimal assertion helpers for the behaviour checks,a failed CHECK is reported and counted,
+//the program keeps going and main() returns the count through report()
+namespace bencode::check {
+    inline int failures = 0;
+
+    inline void fail(const char *file, int line, const char *expr) {
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+        failures++;
+    }
+
+    inline int report(const char *name) {
+        if (failures) {
+            std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+            return 1;
+        }
+        std::printf("%s: ok\n", name);
+        return 0;
+    }
+
+    inline std::string encode(BObject &obj) {
+        std::string out;
+        obj.encode_to(out);
+        return out;
+    }
+
+    //structural equality,dict order is ignored so it holds for every __DICT__ choice
+    inline bool same(BObject &a, BObject &b) {
+        if (auto s = a.Str()) {
+            return b.Str() && *s == *b.Str();
+        }
+        if (a.List()) {
+            auto la = a.List(), lb = b.List();
+            if (!lb || la->size() != lb->size()) return false;
+            for (size_t i = 0; i < la->size(); i++) {
+                if (!same(*(*la)[i], *(*lb)[i])) return false;
+            }
+            return true;
+        }
+        if (auto da = a.Dict()) {
+            auto db = b.Dict();
+            if (!db || da->size() != db->size()) return false;
+            for (auto &&[k, v]: *da) {
+                auto it = db->find(std::string_view(k));
+                if (it == db->end() || !same(*v, *it->second)) return false;
+            }
+            return true;
+        }
+        Error ea, eb;
+        auto da = a.raw_digits(&ea), db = b.raw_digits(&eb);
+        return ea == Error::NoError && eb == Error::NoError && da == db;
+    }
+
+    //keys of these samples are in ascending order,a sorted DICT encodes them back byte for byte
+    inline bool sortedDict() {
+#ifdef U_DICT
+        return false;
+#else
+        return true;
+#endif
+    }
+}
+
+#define CHECK(cond) \
+    do { if (!(cond)) bencode::check::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#endif //TEST_BENCODE_CHECK_H
@@ -0,0 +1,122 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <FlatMap.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::encode;
+using bencode::check::same;
+
+namespace {
+    std::string keysOf(const FlatMap<std::string, int> &map) {
+        std::string ret;
+        for (auto &&[k, v]: map) ret += k;
+        return ret;
+    }
+
+    //FlatMap itself,whatever __DICT__ this variant uses
+    void flatMap() {
+        FlatMap<std::string, int> map;
+        CHECK(map.empty() && map.find("a") == map.end());
+        //ascending keys are appended,anything else is placed by a search
+        for (auto key: {"b", "d", "f", "a", "e", "c"}) {
+            CHECK(map.emplace(std::string(key), int(key[0])).second);
+        }
+        CHECK(map.size() == 6);
+        CHECK(keysOf(map) == "abcdef");
+
+        //an existing key is left alone,like std::map
+        auto [it, inserted] = map.try_emplace("c", 0);
+        CHECK(!inserted && it->second == 'c');
+        CHECK(!map.insert(std::pair<std::string, int>("a", 0)).second && map.at("a") == 'a');
+        map["g"] = 7;
+        map["a"] = 1;
+        CHECK(map.size() == 7 && map.at("a") == 1 && map.at("g") == 7);
+
+        CHECK(map.find(std::string_view("e")) != map.end());
+        CHECK(map.contains("f") && !map.contains("z"));
+        CHECK(map.count("b") == 1 && map.count("") == 0);
+        CHECK(map.lower_bound("cc")->first == "d");
+        CHECK(map.lower_bound("zz") == map.end());
+
+        CHECK(map.erase("b") == 1 && map.erase("b") == 0);
+        CHECK(map.erase(map.find("d"))->first == "e");
+        CHECK(keysOf(map) == "acefg");
+
+        bool threw = false;
+        try {
+            map.at("b");
+        } catch (std::out_of_range &) {
+            threw = true;
+        }
+        CHECK(threw);
+
+        FlatMap<std::string, int> init{{"y", 2}, {"x", 1}, {"y", 3}};
+        CHECK(init.size() == 2 && init.begin()->first == "x" && init.at("y") == 2);
+        FlatMap<std::string, int> other{{"x", 1}, {"y", 2}};
+        CHECK(init == other);
+        other.clear();
+        CHECK(other.empty() && !(init == other));
+    }
+
+    //the dict inside a BObject:lookups by string_view,canonical order where the dict is sorted
+    void nodeDict() {
+        const std::string text = "d1:ai1e1:bl0:e1:cd1:xi2eee";
+        Error error;
+        auto obj = BObject::Parse(std::string_view(text), &error);
+        CHECK(obj && obj->Dict());
+        if (!obj || !obj->Dict()) return;
+        auto dict = obj->Dict();
+        CHECK(dict->size() == 3);
+        CHECK(dict->find(std::string_view("b")) != dict->end());
+        CHECK(dict->find("c") != dict->end() && dict->find("c")->second->Dict());
+        CHECK(dict->find("z") == dict->end());
+        if (check::sortedDict()) {
+            std::string order;
+            for (auto &&[k, v]: *dict) order += std::string_view(k);
+            CHECK(order == "abc");
+            CHECK(encode(*obj) == text);
+        }
+
+        //keys added out of order still encode in canonical order where the dict is sorted
+        BObject built(BObject::DICT{});
+        for (auto key: {"c", "a", "b"}) {
+            built.Dict()->emplace(__KEY__(key), std::make_shared<BObject>(int64_t(key[0] - 'a' + 1)));
+        }
+        auto expect = BObject::Parse(std::string_view("d1:ai1e1:bi2e1:ci3ee"), &error);
+        CHECK(expect && same(built, *expect));
+        if (check::sortedDict()) {
+            CHECK(encode(built) == "d1:ai1e1:bi2e1:ci3ee");
+        }
+        CHECK(built.Dict()->erase(__KEY__("b")) == 1);
+        CHECK(built.Dict()->size() == 2 && built.Dict()->find("b") == built.Dict()->end());
+    }
+
+    //the parser is lenient with keys:the first of two equal keys wins and out of order keys are
+    //accepted,a sorted dict writes them back in canonical order
+    void lenientKeys() {
+        Error error;
+        auto dup = BObject::Parse(std::string_view("d1:ai1e1:ai2ee"), &error);
+        CHECK(dup && dup->Dict() && dup->Dict()->size() == 1);
+        if (dup && dup->Dict()) {
+            CHECK(*dup->Dict()->find("a")->second->Int() == 1);
+        }
+        auto swapped = BObject::Parse(std::string_view("d1:bi1e1:ai2ee"), &error);
+        CHECK(swapped && swapped->Dict() && swapped->Dict()->size() == 2);
+        if (swapped && check::sortedDict()) {
+            CHECK(encode(*swapped) == "d1:ai2e1:bi1ee");
+        }
+    }
+}
+
+int main() {
+    flatMap();
+    nodeDict();
+    lenientKeys();
+    return bencode::check::report("dict_test");
+}
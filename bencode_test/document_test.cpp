@@ -0,0 +1,173 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::same;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i-42e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    std::string encode(Document &doc) {
+        std::ostringstream os;
+        doc.Bencode(os);
+        return os.str();
+    }
+
+    //a Document keeps its dicts in input order,so it writes the input back byte for byte
+    void roundTrip() {
+        for (auto &&text: Samples) {
+            Error error;
+            size_t used = 0;
+            auto doc = Document::Parse(text, &error, &used);
+            CHECK(error == Error::NoError);
+            CHECK(used == text.size());
+            CHECK(doc.buffer() == text);
+            CHECK(encode(doc) == text);
+            auto copy = doc.root().to_object();
+            auto direct = BObject::Parse(std::string_view(text), &error);
+            CHECK(copy && direct && same(*copy, *direct));
+        }
+    }
+
+    //strings and keys point into the parsed buffer,nothing is copied
+    void borrowsTheBuffer() {
+        std::string text = "d4:name5:a.txte";
+        Error error;
+        auto doc = Document::Parse(text, &error);
+        auto dict = doc.root().Dict();
+        CHECK(dict && dict->size() == 1);
+        auto it = dict->find("name");
+        CHECK(it != dict->end());
+        auto str = it->second.Str();
+        CHECK(str && *str == "a.txt");
+        CHECK(str->data() >= text.data() && str->data() < text.data() + text.size());
+        CHECK(it->first.data() >= text.data() && it->first.data() < text.data() + text.size());
+    }
+
+    //a failed parse or a default node is a usable empty value,not a dangling one
+    void emptyAndFailed() {
+        Error error;
+        auto doc = Document::Parse("xyz", &error);
+        CHECK(error != Error::NoError);
+        CHECK(doc.buffer().empty());
+        CHECK(encode(doc) == "");
+
+        BView view;
+        auto str = view.Str();
+        CHECK(str && str->empty());
+        std::ostringstream os;
+        CHECK(view.Bencode(os) == 2);
+        CHECK(os.str() == "0:");
+        auto obj = view.to_object();
+        CHECK(obj && obj->Str() && obj->Str()->empty());
+        CHECK(view.Int() == nullptr && view.List() == nullptr && view.Dict() == nullptr);
+
+        for (std::string bad: {"", "l", "d1:a", "i03e", "3:ab", "di1ei2ee"}) {
+            auto d = Document::Parse(bad, &error);
+            CHECK(error != Error::NoError);
+            CHECK(encode(d) == "");
+        }
+    }
+
+    //a file of its own per run,the variants may run side by side
+    std::filesystem::path tempFile(const std::string &content) {
+        auto path = std::filesystem::temp_directory_path() /
+                    ("bencode_document_test_" + std::to_string(std::random_device{}()) + ".torrent");
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    //strings point into the mapping,which lives exactly as long as the Document
+    void mappedFile() {
+        const std::string text = "d4:infod6:lengthi12e4:name5:a.txtee";
+        auto path = tempFile(text);
+        Error error;
+        Document doc;
+        {
+            auto mapped = Document::open_mapped(path.string(), &error);
+            CHECK(error == Error::NoError);
+            doc = std::move(mapped);
+        }
+        CHECK(doc.buffer() == text);
+        CHECK(encode(doc) == text);
+        auto info = doc.root().Dict() ? doc.root().Dict()->find("info") : nullptr;
+        CHECK(info && info != doc.root().Dict()->end());
+        if (info && info != doc.root().Dict()->end()) {
+            auto name = info->second.Dict()->find("name")->second.Str();
+            CHECK(name && *name == "a.txt");
+            CHECK(name->data() >= doc.buffer().data() && name->data() < doc.buffer().data() + text.size());
+        }
+        std::filesystem::remove(path);
+
+        auto missing = Document::open_mapped(path.string(), &error);
+        CHECK(error == Error::ErrSys && missing.buffer().empty());
+        auto empty = tempFile("");
+        Document::open_mapped(empty.string(), &error);
+        CHECK(error == Error::ErrIvd);
+        std::filesystem::remove(empty);
+        auto broken = tempFile("d4:infoi03ee");
+        auto bad = Document::open_mapped(broken.string(), &error);
+        CHECK(error == Error::ErrNum && bad.buffer().empty());
+        std::filesystem::remove(broken);
+        ParseLimits shallow;
+        shallow.max_depth = 1;
+        auto deep = tempFile(text);
+        Document::open_mapped(deep.string(), &error, shallow);
+        CHECK(error == Error::ErrDep);
+        std::filesystem::remove(deep);
+    }
+
+    //nodes come from the Document's arena:siblings are contiguous and reset() keeps one block
+    void arenaStorage() {
+        Error error;
+        auto doc = Document::Parse("li1ei2ei3ee", &error);
+        auto list = doc.root().List();
+        CHECK(list && list->size() == 3);
+        if (list && list->size() == 3) {
+            CHECK(&(*list)[1] == &(*list)[0] + 1);
+            CHECK(&(*list)[2] == &(*list)[1] + 1);
+        }
+
+        Arena arena(64);
+        auto a = arena.allocate(3, 1);
+        auto b = arena.allocate(8, 8);
+        CHECK(reinterpret_cast<uintptr_t>(b) % 8 == 0);
+        CHECK(a != b);
+        auto big = arena.allocate_array<uint64_t>(100);
+        CHECK(big != nullptr && reinterpret_cast<uintptr_t>(big) % alignof(uint64_t) == 0);
+        CHECK(arena.allocate_array<uint64_t>(0) == nullptr);
+        auto cap = arena.capacity();
+        CHECK(cap >= 64 + 800);
+        arena.reset();
+        CHECK(arena.capacity() < cap);
+        CHECK(arena.capacity() >= 800);
+    }
+}
+
+int main() {
+    roundTrip();
+    arenaStorage();
+    borrowsTheBuffer();
+    emptyAndFailed();
+    mappedFile();
+    return bencode::check::report("document_test");
+}
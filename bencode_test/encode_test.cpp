@@ -0,0 +1,203 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace bencode;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i0e",
+            "i-9223372036854775808e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+    };
+
+    std::shared_ptr<BObject> parse(const std::string &text) {
+        Error error;
+        return BObject::Parse(std::string_view(text), &error);
+    }
+
+    std::string stream(BObject &obj) {
+        std::ostringstream os;
+        obj.Bencode(os);
+        return os.str();
+    }
+
+    //encode_to(std::string) appends the same bytes the ostream encoder writes
+    void toString() {
+        for (auto &&text: Samples) {
+            auto obj = parse(text);
+            if (!obj) {
+                CHECK(obj != nullptr);
+                continue;
+            }
+            std::string out = "prefix";
+            CHECK(obj->encode_to(out) == int(stream(*obj).size()));
+            CHECK(out == "prefix" + stream(*obj));
+        }
+    }
+
+    //a short buffer gets a prefix of the encoding and nothing past cap,the return value
+    //is always the full length
+    void toBuffer() {
+        for (auto &&text: Samples) {
+            auto obj = parse(text);
+            if (!obj) continue;
+            auto bytes = stream(*obj);
+            for (size_t cap = 0; cap <= bytes.size(); cap++) {
+                std::string buf(bytes.size() + 4, '#');
+                CHECK(obj->encode_to(buf.data(), cap) == int(bytes.size()));
+                CHECK(buf.compare(0, cap, bytes, 0, cap) == 0);
+                CHECK(buf.find_first_not_of('#', cap) == std::string::npos);
+            }
+        }
+        auto obj = parse("li1ee");
+        CHECK(obj && obj->encode_to(nullptr, 0) == 5);
+    }
+
+    //encoded_size() is exact,so one buffer of that size always holds the whole encoding
+    void exactSize() {
+        for (auto &&text: Samples) {
+            auto obj = parse(text);
+            if (!obj) continue;
+            auto size = obj->encoded_size();
+            CHECK(size == stream(*obj).size());
+            std::string buf(size, '\0');
+            CHECK(obj->encode_to(buf.data(), buf.size()) == int(size));
+            CHECK(buf == stream(*obj));
+        }
+
+        BEntity<DICT> dict;
+        CHECK(dict.encoded_size() == 2);
+        dict.put("name", BObject("a.txt"));
+        dict.put("length", BObject(int64_t(-12345678901)));
+        std::ostringstream os;
+        dict.bencode(os);
+        CHECK(dict.encoded_size() == os.str().size());
+        BEntity<LIST> list;
+        list.add(BObject("")).add(BObject(int64_t(0)));
+        CHECK(list.encoded_size() == 7);//"l0:i0ee"
+        BEntity<int> num;
+        num.set(-1);
+        CHECK(num.encoded_size() == 4);
+        BEntity<std::string> str;
+        str.set(std::string(1000, 'x'));
+        CHECK(str.encoded_size() == 1005);
+    }
+
+    //a Writer produces what encoding the equivalent tree produces
+    void writer() {
+        Writer w;
+        w.begin_dict().key("info").begin_dict();
+        w.key("length").value(int64_t(12)).key("name").value("a.txt");
+        w.key("piece length").value(int64_t(262144)).end();
+        w.key("list").begin_list().value("").value(int64_t(-1)).begin_list().end().begin_dict().end().end();
+        w.end();
+        const std::string text = "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144ee"
+                                 "4:listl0:i-1eledeee";
+        CHECK(w.str() == text);
+        auto obj = parse(text);
+        CHECK(obj != nullptr);
+        if (obj && check::sortedDict()) CHECK(check::encode(*obj) == text);
+
+        //appends to a caller's buffer and takes a tree as one value
+        std::string out = "xx";
+        Writer into(out);
+        BObject big(BigInt::Parse("123456789012345678901"));
+        into.begin_list().value(big).value(int64_t(INT64_MIN)).end();
+        CHECK(out == "xxli123456789012345678901ei-9223372036854775808ee");
+        CHECK(w.take() == text);
+    }
+
+    bool throws(void (*fn)(Writer &)) {
+        Writer w;
+        try {
+            fn(w);
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    }
+
+    //nesting and key order are checked unless NDEBUG is defined
+    void writerChecks() {
+#ifndef NDEBUG
+        CHECK(throws([](Writer &w) { w.begin_dict().key("b").value(int64_t(1)).key("a"); }));
+        CHECK(throws([](Writer &w) { w.begin_dict().key("a").value(int64_t(1)).key("a"); }));
+        CHECK(throws([](Writer &w) { w.begin_dict().value(int64_t(1)); }));
+        CHECK(throws([](Writer &w) { w.begin_dict().key("a").end(); }));
+        CHECK(throws([](Writer &w) { w.begin_list().key("a"); }));
+        CHECK(throws([](Writer &w) { w.end(); }));
+        CHECK(throws([](Writer &w) { w.value(int64_t(1)).value(int64_t(2)); }));
+        CHECK(throws([](Writer &w) { w.begin_list().end().begin_list(); }));
+        CHECK(!throws([](Writer &w) { w.begin_dict().key("").value("").key("a").begin_list().end().end(); }));
+#endif
+    }
+
+#ifdef BENCODE_HAS_IOVEC
+    std::string join(const std::vector<iovec> &iov) {
+        std::string ret;
+        for (auto &&v: iov) ret.append(static_cast<const char *>(v.iov_base), v.iov_len);
+        return ret;
+    }
+
+    //long strings are referenced in place,everything else goes through scratch
+    void gather() {
+        auto pieces = std::string(200, 'p');
+        Writer w;
+        w.begin_dict().key("a").value("short").key("pieces").value(pieces).key("z").value(int64_t(7)).end();
+        auto obj = parse(w.str());
+        if (!obj) {
+            CHECK(obj != nullptr);
+            return;
+        }
+        auto bytes = stream(*obj);
+        for (size_t min_ref: {size_t(0), size_t(1), size_t(5), size_t(64), size_t(1000)}) {
+            std::vector<iovec> iov(3);
+            std::string scratch = "stale";
+            CHECK(obj->encode_to(iov, scratch, min_ref) == int(bytes.size()));
+            CHECK(join(iov) == bytes);
+        }
+        std::vector<iovec> iov;
+        std::string scratch;
+        obj->encode_to(iov, scratch);
+        auto stored = obj->Dict()->find(std::string_view("pieces"))->second->Str();
+        bool referenced = false;
+        for (auto &&v: iov) {
+            if (v.iov_base == stored->data() && v.iov_len == stored->size()) referenced = true;
+        }
+        CHECK(referenced);
+        CHECK(scratch.size() + pieces.size() == bytes.size());
+
+        for (auto &&text: Samples) {
+            auto each = parse(text);
+            if (!each) continue;
+            CHECK(each->encode_to(iov, scratch, 1) == int(stream(*each).size()));
+            CHECK(join(iov) == stream(*each));
+        }
+    }
+#endif
+}
+
+int main() {
+    toString();
+    toBuffer();
+    exactSize();
+    writer();
+    writerChecks();
+#ifdef BENCODE_HAS_IOVEC
+    gather();
+#endif
+    return bencode::check::report("encode_test");
+}
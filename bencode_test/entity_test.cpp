@@ -0,0 +1,138 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace bencode;
+
+struct Peer {
+    std::string ip;
+    int64_t port = 0;
+};
+
+void to_bencode(Bencode &b, const Peer &peer) {
+    b["ip"] = peer.ip;
+    b["port"] = peer.port;
+}
+
+void from_bencode(Bencode &b, Peer &peer) {
+    peer.ip = b["ip"].take<std::string>();
+    b["port"].get_to(peer.port);
+}
+
+namespace {
+    using StrMap = __DICT__<std::string, std::string>;
+
+    std::shared_ptr<BObject> parse(const std::string &text) {
+        Error error;
+        return BObject::Parse(std::string_view(text), &error);
+    }
+
+    std::string write(Bencode &b) {
+        std::string out;
+        b.encode_to(out);
+        return out;
+    }
+
+    BObject &at(BObject &dict, std::string_view key) {
+        return *dict.Dict()->find(key)->second;
+    }
+
+    //long enough to live on the heap,a moved string keeps its buffer
+    std::string text(char c) {
+        return std::string(100, c);
+    }
+
+    //rvalues are moved into the tree,lvalues are copied and left alone
+    void putMoves() {
+        auto root = std::make_shared<BObject>(BObject::DICT{});
+        Bencode b(root);
+
+        auto str = text('a');
+        auto buf = str.data();
+        b["str"] = std::move(str);
+        CHECK(at(*root, "str").Str()->data() == buf);
+
+        std::vector<std::string> vec{text('b'), text('c')};
+        auto first = vec[0].data();
+        b["vec"] = std::move(vec);
+        CHECK((*at(*root, "vec").List())[0]->Str()->data() == first);
+
+        StrMap map{{"k", text('d')}};
+        auto value = map.begin()->second.data();
+        b["map"] = std::move(map);
+        CHECK(at(at(*root, "map"), "k").Str()->data() == value);
+
+        std::vector<std::vector<std::string>> nested{{text('e')}};
+        auto inner = nested[0][0].data();
+        b["nested"] = std::move(nested);
+        CHECK((*(*at(*root, "nested").List())[0]->List())[0]->Str()->data() == inner);
+
+        const auto kept = text('f');
+        b["copy"] = kept;
+        CHECK(kept == text('f') && at(*root, "copy").Str()->data() != kept.data());
+
+        b["peer"] = Peer{"10.0.0.1", 6881};
+        b.append(text('g')).append(std::vector<int>{1, 2});
+        auto expect = parse("d4:copy100:" + text('f') + "3:mapd1:k100:" + text('d') + "e6:nestedll100:" + text('e') +
+                            "ee4:LISTl100:" + text('g') + "li1ei2eee4:peerd2:ip8:10.0.0.14:porti6881ee3:str100:" +
+                            text('a') + "3:vecl100:" + text('b') + "100:" + text('c') + "ee");
+        CHECK(expect && check::same(*root, *expect));
+    }
+
+    //get copies,take moves the strings out and leaves empty strings behind
+    void getAndTake() {
+        auto root = parse("d4:listl3:abc3:defe3:mapd1:a3:xyze4:name4:teste");
+        Bencode b(root);
+        CHECK(b["name"].get<std::string>() == "test");
+        CHECK(*at(*root, "name").Str() == "test");
+        CHECK(b["name"].take<std::string>() == "test");
+        CHECK(at(*root, "name").Str()->empty());
+
+        auto list = b["list"].get<std::vector<std::string>>();
+        CHECK(list == std::vector<std::string>({"abc", "def"}));
+        list = b["list"].take<std::vector<std::string>>();
+        CHECK(list == std::vector<std::string>({"abc", "def"}));
+        CHECK((*at(*root, "list").List())[1]->Str()->empty());
+
+        auto map = b["map"].take<StrMap>();
+        CHECK(map.size() == 1 && map.begin()->second == "xyz");
+        CHECK(at(at(*root, "map"), "a").Str()->empty());
+
+        //integers are read,never taken
+        auto ints = parse("d1:lli1ei2eee");
+        Bencode c(ints);
+        CHECK(c["l"].take<std::vector<int64_t>>() == std::vector<int64_t>({1, 2}));
+        CHECK(c["l"].get<std::vector<int64_t>>() == std::vector<int64_t>({1, 2}));
+    }
+
+    //every take marks the container it changed,so a cached encoding is redone where it has to be
+    void takeWithCache() {
+        auto root = parse("d5:peersld2:ip4:ipv44:porti1eee4:listl1:x1:ye3:mapd1:a1:bee");
+        Bencode b(root);
+        b.cache_encoding();
+        write(b);
+        auto peers = b["peers"].get<std::vector<Peer>>();
+        CHECK(peers.size() == 1 && peers[0].ip == "ipv4" && peers[0].port == 1);
+        auto expect = parse("d5:peersld2:ip0:4:porti1eee4:listl1:x1:ye3:mapd1:a1:bee");
+        auto encoded = parse(write(b));
+        CHECK(encoded && expect && check::same(*encoded, *expect));
+
+        b["list"].take<std::vector<std::string>>();
+        b["map"].take<StrMap>();
+        expect = parse("d5:peersld2:ip0:4:porti1eee4:listl0:0:e3:mapd1:a0:ee");
+        encoded = parse(write(b));
+        CHECK(encoded && expect && check::same(*encoded, *expect));
+    }
+}
+
+int main() {
+    putMoves();
+    getAndTake();
+    takeWithCache();
+    return bencode::check::report("entity_test");
+}
@@ -0,0 +1,127 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::same;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i0e",
+            "i-42e",
+            "i9223372036854775807e",
+            "i-9223372036854775808e",
+            "i123456789012345678901234567890e",
+            "i-123456789012345678901234567890e",
+            "le",
+            "de",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    //non-canonical integers of every length and truncated input
+    const std::vector<std::string> Broken = {
+            "", "x", "i", "ie", "i-e", "i1", "i03e", "i-0e", "i00e", "i007e", "i-03e",
+            "i0123456789e", "i-0123456789012345678901234567890e", "i1.5e",
+            "3:ab", "1", "l", "li1e", "d", "d1:a", "d1:ai1e", "di1ei2ee", "d1:ae",
+    };
+
+    std::string write(const Tape &tape) {
+        std::ostringstream os;
+        tape.Bencode(os);
+        return os.str();
+    }
+
+    //a message long enough to cross several 64-byte blocks,strings straddle block edges
+    std::string longMessage() {
+        Writer w;
+        w.begin_list();
+        for (int i = 0; i < 50; i++) {
+            w.value(std::string(i * 7 % 90, char('a' + i % 26)));
+            w.value(int64_t(i) * 1000003 - 25000000);
+            w.begin_dict().key("k").value("v").end();
+        }
+        w.end();
+        return w.take();
+    }
+
+    void roundTrip() {
+        auto all = Samples;
+        all.push_back(longMessage());
+        for (auto &&text: all) {
+            Error error;
+            size_t used = 0;
+            auto index = StructuralIndex::Build(text, &error, &used);
+            CHECK(error == Error::NoError);
+            CHECK(used == text.size());
+            auto obj = index.ToObject(&error);
+            CHECK(error == Error::NoError);
+            auto direct = BObject::Parse(std::string_view(text), &error);
+            CHECK(obj && direct && same(*obj, *direct));
+            auto tape = index.ToTape(&error);
+            CHECK(error == Error::NoError);
+            CHECK(write(tape) == text);
+            if (obj) {
+                auto again = StructuralIndex::Build(check::encode(*obj), &error).ToObject(&error);
+                CHECK(again && same(*obj, *again));
+            }
+        }
+    }
+
+    //offsets of an input past 4 GiB fit,such a buffer is indexed rather than rejected
+    static_assert(std::is_same_v<std::decay_t<decltype(StructuralIndex().positions())>::value_type, uint64_t>);
+
+    //stage 1 must reject exactly what the scalar parser rejects
+    void agreesWithScalar() {
+        for (auto &&text: Broken) {
+            Error e1, e2;
+            auto index = StructuralIndex::Build(text, &e1);
+            BObject::Parse(std::string_view(text), &e2);
+            CHECK(e1 != Error::NoError);
+            CHECK(e2 != Error::NoError);
+            CHECK(index.positions().empty());
+            CHECK(index.ToObject(&e1) == nullptr);
+            CHECK(index.ToTape(&e1).empty());
+            if (e1 == Error::NoError) std::fprintf(stderr, "  broken sample %s accepted\n", text.c_str());
+        }
+        Error error;
+        StructuralIndex::Build("i03e", &error);
+        CHECK(error == Error::ErrNum);
+        StructuralIndex::Build("i-0e", &error);
+        CHECK(error == Error::ErrNum);
+        StructuralIndex::Build("li1ei007ee", &error);
+        CHECK(error == Error::ErrNum);
+    }
+
+    void limits() {
+        Error error;
+        ParseLimits shallow;
+        shallow.max_depth = 2;
+        StructuralIndex::Build("llee", &error, nullptr, shallow);
+        CHECK(error == Error::NoError);
+        StructuralIndex::Build("llleee", &error, nullptr, shallow);
+        CHECK(error == Error::ErrDep);
+        ParseLimits few;
+        few.max_nodes = 3;
+        StructuralIndex::Build("li1ei2ee", &error, nullptr, few);
+        CHECK(error == Error::NoError);
+        StructuralIndex::Build("li1ei2ei3ee", &error, nullptr, few);
+        CHECK(error == Error::ErrCnt);
+    }
+}
+
+int main() {
+    roundTrip();
+    agreesWithScalar();
+    limits();
+    return bencode::check::report("index_test");
+}
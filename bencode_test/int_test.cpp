@@ -0,0 +1,165 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+
+using namespace bencode;
+
+namespace {
+    int64_t decode(const std::string &text, Error *error, size_t *used = nullptr) {
+        auto cur = text.data();
+        auto val = BObject::DecodeInt(cur, text.data() + text.size(), error);
+        if (used)*used = cur - text.data();
+        return val;
+    }
+
+    //every digit count the SWAR path splits into chunks of eight,with both signs
+    void everyLength() {
+        std::mt19937_64 rng(12);
+        for (int len = 1; len <= 19; len++) {
+            for (int round = 0; round < 50; round++) {
+                std::string digits(1, char('1' + rng() % 9));
+                while (int(digits.size()) < len) digits += char('0' + rng() % 10);
+                for (bool neg: {false, true}) {
+                    auto text = std::string("i") + (neg ? "-" : "") + digits + "e";
+                    auto expect = std::stoull(digits);
+                    Error error;
+                    size_t used = 0;
+                    auto val = decode(text, &error, &used);
+                    if (expect > uint64_t(INT64_MAX) + neg) {
+                        CHECK(error == Error::ErrNum);
+                        continue;
+                    }
+                    CHECK(error == Error::NoError);
+                    CHECK(used == text.size());
+                    CHECK(val == (neg ? int64_t(0 - expect) : int64_t(expect)));
+                    std::ostringstream os;
+                    CHECK(BObject::EncodeInt(os, val) == int(text.size()));
+                    CHECK(os.str() == text);
+                }
+            }
+        }
+    }
+
+    void bounds() {
+        Error error;
+        CHECK(decode("i9223372036854775807e", &error) == INT64_MAX && error == Error::NoError);
+        CHECK(decode("i-9223372036854775808e", &error) == INT64_MIN && error == Error::NoError);
+        decode("i9223372036854775808e", &error);
+        CHECK(error == Error::ErrNum);
+        decode("i-9223372036854775809e", &error);
+        CHECK(error == Error::ErrNum);
+        decode("i99999999999999999999e", &error);
+        CHECK(error == Error::ErrNum);
+        CHECK(decode("i0e", &error) == 0 && error == Error::NoError);
+
+        for (std::string bad: {"i03e", "i-0e", "i00e", "i-03e", "ie", "i-e", "i1", "i12345678", "i1x", "x"}) {
+            size_t used = 7;
+            decode(bad, &error, &used);
+            CHECK(error != Error::NoError);
+            CHECK(used == 0);
+        }
+        decode("i12345678", &error);
+        CHECK(error == Error::ErrEpE);
+
+        BObject big(INT64_MIN);
+        CHECK(check::encode(big) == "i-9223372036854775808e");
+        CHECK(big.encoded_size() == 22);
+    }
+
+    void conversions() {
+        Error error;
+        auto obj = BObject::Parse(std::string_view("li255ei256ei-1ei4294967296ee"), &error);
+        CHECK(obj && obj->List() && obj->List()->size() == 4);
+        if (!obj || !obj->List() || obj->List()->size() != 4) return;
+        auto &list = *obj->List();
+        CHECK(list[0]->as<uint8_t>(&error) == 255 && error == Error::NoError);
+        CHECK(list[1]->as<uint8_t>(&error) == 0 && error == Error::ErrNum);
+        CHECK(list[2]->as<uint32_t>(&error) == 0 && error == Error::ErrNum);
+        CHECK(list[2]->as<int8_t>(&error) == -1 && error == Error::NoError);
+        CHECK(list[3]->as<int32_t>(&error) == 0 && error == Error::ErrNum);
+        CHECK(list[3]->as<int64_t>(&error) == 4294967296 && error == Error::NoError);
+        BObject str("abc");
+        CHECK(str.as<int>(&error) == 0 && error == Error::ErrTyp);
+    }
+
+    void bigInt() {
+        Error error;
+        for (std::string text: {"0", "-1", "9223372036854775808", "-9223372036854775809",
+                                "123456789012345678901234567890"}) {
+            auto big = BigInt::Parse(text, &error);
+            CHECK(error == Error::NoError && big.digits() == text);
+        }
+        for (std::string bad: {"", "-", "-0", "00", "012", "1x", "+1", "1 "}) {
+            BigInt::Parse(bad, &error);
+            CHECK(error == Error::ErrNum);
+        }
+        CHECK(BigInt(INT64_MIN).digits() == "-9223372036854775808");
+        CHECK(BigInt::Parse("18446744073709551615").as<uint64_t>(&error) == UINT64_MAX && error == Error::NoError);
+        BigInt::Parse("18446744073709551616").as<uint64_t>(&error);
+        CHECK(error == Error::ErrNum);
+        CHECK(BigInt::Parse("-9223372036854775808").as<int64_t>(&error) == INT64_MIN && error == Error::NoError);
+        BigInt::Parse("-1").as<uint32_t>(&error);
+        CHECK(error == Error::ErrNum);
+        CHECK(BigInt::Parse("-5") < BigInt::Parse("-4"));
+        CHECK(BigInt::Parse("-100000000000000000000") < BigInt::Parse("-99999999999999999999"));
+        CHECK(BigInt::Parse("99999999999999999999") < BigInt::Parse("100000000000000000000"));
+        CHECK(BigInt::Parse("1e", &error).digits() == "0" && error == Error::ErrNum);
+        CHECK(BigInt::Parse("100000000000000000000").to_double() == 1e20);
+    }
+
+    //an integer outside int64_t keeps its digits through every parser and encoder
+    void bigRoundTrip() {
+        const std::string text = "li-123456789012345678901234567890ei18446744073709551616ei5ee";
+        Error error;
+        auto obj = BObject::Parse(std::string_view(text), &error);
+        CHECK(obj && check::encode(*obj) == text);
+        if (obj && obj->List()) {
+            auto &first = *(*obj->List())[0];
+            CHECK(first.Int(&error) == nullptr && error == Error::ErrNum);
+            CHECK(first.raw_digits() == "-123456789012345678901234567890");
+            CHECK(first.as_bigint().negative());
+            CHECK((*obj->List())[1]->as<uint64_t>(&error) == 0 && error == Error::ErrNum);
+            CHECK((*obj->List())[2]->as_bigint().digits() == "5");
+        }
+        std::istringstream in(text);
+        auto streamed = BObject::Parse(in, &error);
+        CHECK(streamed && check::encode(*streamed) == text);
+
+        auto doc = Document::Parse(text, &error);
+        std::ostringstream dos;
+        doc.Bencode(dos);
+        CHECK(dos.str() == text);
+        CHECK(doc.root().List() && (*doc.root().List())[0].raw_digits() == "-123456789012345678901234567890");
+
+        auto tape = Tape::Parse(text, &error);
+        std::ostringstream tos;
+        tape.Bencode(tos);
+        CHECK(tos.str() == text);
+        CHECK(tape.root().List().at(1).as_bigint().digits() == "18446744073709551616");
+
+        CHECK(lazy_parse(text)[size_t(1)].raw_digits() == "18446744073709551616");
+        PushParser push;
+        CHECK(push.feed(text) == Feed::Done);
+        auto pushed = push.take();
+        CHECK(pushed && check::encode(*pushed) == text);
+
+        BObject made(BigInt::Parse("-99999999999999999999"));
+        CHECK(check::encode(made) == "i-99999999999999999999e");
+        CHECK(made.encoded_size() == 23);
+    }
+}
+
+int main() {
+    everyLength();
+    bounds();
+    conversions();
+    bigInt();
+    bigRoundTrip();
+    return bencode::check::report("int_test");
+}
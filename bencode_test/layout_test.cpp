@@ -0,0 +1,108 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <utility>
+
+using namespace bencode;
+using bencode::check::encode;
+using bencode::check::same;
+
+namespace {
+    std::shared_ptr<BObject> parse(const std::string &text) {
+        Error error;
+        return BObject::Parse(std::string_view(text), &error);
+    }
+
+    //a one byte tag,an 8 byte payload and the cache pointer
+    void layout() {
+        CHECK(sizeof(BObject) == 24);
+        BObject def;
+        CHECK(def.Int() && *def.Int() == 0);
+        CHECK(BObject(int8_t(-5)).as<int>() == -5);
+        CHECK(BObject(uint32_t(7)).as<int64_t>() == 7);
+        CHECK(*BObject("abc").Str() == "abc");
+        CHECK(BObject(BigInt::Parse("123456789012345678901234567890")).raw_digits() == "123456789012345678901234567890");
+        CHECK(BObject(BObject::LIST{}).List() && BObject(BObject::DICT{}).Dict());
+        Error error;
+        CHECK(BObject("abc").Int(&error) == nullptr && error == Error::ErrTyp);
+        CHECK(BObject(int64_t(1)).Str(&error) == nullptr && error == Error::ErrTyp);
+    }
+
+    //a copy owns its own string or container,the elements of a container are shared nodes
+    void copies() {
+        for (std::string text: {"4:spam", "i-42e", "i123456789012345678901234567890e", "l0:i1ee", "d1:ai1ee"}) {
+            auto obj = parse(text);
+            CHECK(obj != nullptr);
+            if (!obj) continue;
+            BObject copy(*obj);
+            CHECK(same(copy, *obj));
+            BObject assigned;
+            assigned = *obj;
+            CHECK(same(assigned, *obj));
+        }
+
+        BObject str("abc");
+        BObject strCopy(str);
+        *strCopy.Str() = "xyz";
+        CHECK(*str.Str() == "abc");
+
+        auto list = parse("li1ei2ee");
+        BObject listCopy(*list);
+        CHECK(listCopy.List() != list->List());
+        listCopy.List()->pop_back();
+        CHECK(list->List()->size() == 2);
+        CHECK((*listCopy.List())[0] == (*list->List())[0]);
+    }
+
+    //the source of a move is left holding the integer 0
+    void moves() {
+        auto obj = parse("d1:ali1ei2eee");
+        auto dict = obj->Dict();
+        BObject moved(std::move(*obj));
+        CHECK(moved.Dict() == dict);
+        CHECK(obj->Int() && *obj->Int() == 0);
+
+        BObject target("old");
+        target = std::move(moved);
+        CHECK(target.Dict() == dict);
+        CHECK(moved.Int() && *moved.Int() == 0);
+        CHECK(encode(target) == "d1:ali1ei2eee");
+
+        auto &self = target;
+        target = self;
+        CHECK(target.Dict() && encode(target) == "d1:ali1ei2eee");
+    }
+
+    //assigning a descendant into its ancestor takes the value before the old one is freed
+    void fromDescendant() {
+        auto obj = parse("d1:ald1:bi7eeee");
+        auto &list = *obj->Dict()->find("a")->second;
+        *obj = list;
+        CHECK(encode(*obj) == "ld1:bi7eee");
+
+        auto other = parse("lld1:bi7eeee");
+        auto &inner = *(*other->List())[0];
+        *other = std::move(inner);
+        CHECK(encode(*other) == "ld1:bi7eee");
+
+        //the scalar setters replace containers of any type
+        *other = int64_t(3);
+        CHECK(encode(*other) == "i3e");
+        *other = std::string("s");
+        CHECK(encode(*other) == "1:s");
+        *other = BObject::LIST{};
+        CHECK(encode(*other) == "le");
+        *other = BObject::DICT{};
+        CHECK(encode(*other) == "de");
+    }
+}
+
+int main() {
+    layout();
+    copies();
+    moves();
+    fromDescendant();
+    return bencode::check::report("layout_test");
+}
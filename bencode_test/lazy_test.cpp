@@ -0,0 +1,82 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <stdexcept>
+
+using namespace bencode;
+using bencode::check::same;
+
+namespace {
+    const std::string Torrent =
+            "d8:announce3:url4:infod5:filesld6:lengthi1e4:pathl1:aeed6:lengthi2e4:pathl1:beee"
+            "4:name4:demo6:piecesi123456789012345678901234567890eee";
+
+    void lookups() {
+        auto root = lazy_parse(Torrent);
+        CHECK(root.type() == BType::BDICT);
+        CHECK(root["announce"].get<std::string_view>() == "url");
+        CHECK(root["info"]["name"].get<std::string>() == "demo");
+        CHECK(root["info"]["files"][1]["length"].get<int64_t>() == 2);
+        CHECK(root["info"]["files"][0]["path"][0].Str() == "a");
+        CHECK(root["info"]["files"].type() == BType::BLIST);
+
+        Error error;
+        CHECK(root["info"]["pieces"].Int(&error) == 0 && error == Error::ErrNum);
+        CHECK(root["info"]["pieces"].raw_digits() == "123456789012345678901234567890");
+        CHECK(root["info"]["pieces"].as_bigint().digits() == "123456789012345678901234567890");
+        CHECK(root["info"]["files"][0]["length"].as<uint8_t>(&error) == 1 && error == Error::NoError);
+    }
+
+    //raw() is the exact encoded slice,e.g. the bytes an info hash is taken over
+    void rawAndObject() {
+        auto info = lazy_parse(Torrent)["info"];
+        Error error;
+        auto bytes = info.raw(&error);
+        CHECK(error == Error::NoError);
+        CHECK(Torrent.find(bytes) != std::string::npos);
+        CHECK(bytes.front() == 'd' && bytes.back() == 'e');
+        auto obj = info.to_object(&error);
+        auto direct = BObject::Parse(bytes, &error);
+        CHECK(obj && direct && same(*obj, *direct));
+        if (obj && check::sortedDict()) CHECK(check::encode(*obj) == bytes);
+        CHECK(lazy_parse("i7e").raw() == "i7e");
+        CHECK(lazy_parse("0:").Str(&error).empty() && error == Error::NoError);
+    }
+
+    //a failed step carries its error through every later one
+    void errors() {
+        auto root = lazy_parse(Torrent);
+        CHECK(root["missing"].error() == Error::ErrNfd);
+        CHECK(root["missing"]["deeper"][3].error() == Error::ErrNfd);
+        CHECK(root["announce"]["x"].error() == Error::ErrTyp);
+        CHECK(root[size_t(0)].error() == Error::ErrTyp);
+        CHECK(root["info"]["files"][5].error() == Error::ErrNfd);
+        Error error;
+        CHECK(root["missing"].to_object(&error) == nullptr && error == Error::ErrNfd);
+        CHECK(root["announce"].Int(&error) == 0 && error == Error::ErrTyp);
+
+        bool thrown = false;
+        try {
+            root["announce"].get<int64_t>();
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        CHECK(thrown);
+
+        CHECK(lazy_parse("").error() == Error::ErrIvd);
+        CHECK(lazy_parse("d1:a")["b"].error() != Error::NoError);
+        CHECK(lazy_parse("d1:ai03e1:bi1ee")["b"].error() == Error::ErrNum);
+        CHECK(lazy_parse("li1e")[size_t(3)].error() == Error::ErrEpE);
+        lazy_parse("l3:ab").raw(&error);
+        CHECK(error != Error::NoError);
+    }
+}
+
+int main() {
+    lookups();
+    rawAndObject();
+    errors();
+    return bencode::check::report("lazy_test");
+}
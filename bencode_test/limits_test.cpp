@@ -0,0 +1,123 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <sstream>
+#include <string>
+
+using namespace bencode;
+
+namespace {
+    //depth levels of nested lists around an integer,or of dicts keyed "a" when dict is set
+    std::string nested(size_t depth, bool dict = false) {
+        std::string ret;
+        for (size_t i = 0; i < depth; i++) ret += dict ? "d1:a" : "l";
+        ret += "i1e";
+        ret.append(depth, 'e');
+        return ret;
+    }
+
+    //one error per parser,in a fixed order,for the same input and limits
+    std::vector<Error> parseAll(const std::string &text, const ParseLimits &limits) {
+        std::vector<Error> ret(7, Error::NoError);
+        BObject::Parse(std::string_view(text), &ret[0], nullptr, limits);
+        Document::Parse(text, &ret[1], nullptr, limits);
+        Tape::Parse(text, &ret[2], nullptr, limits);
+        StructuralIndex::Build(text, &ret[3], nullptr, limits);
+        Reader r(text, limits);
+        while (r.next()) {}
+        ret[4] = r.error();
+        PushParser p(limits);
+        p.feed(text);
+        ret[5] = p.error();
+        std::istringstream in(text);
+        BObject::Parse(in, &ret[6], limits);
+        return ret;
+    }
+
+    void depthLimit() {
+        ParseLimits limits;
+        limits.max_depth = 3;
+        for (bool dict: {false, true}) {
+            for (auto e: parseAll(nested(3, dict), limits)) CHECK(e == Error::NoError);
+            for (auto e: parseAll(nested(4, dict), limits)) CHECK(e == Error::ErrDep);
+        }
+        //the default limit turns away hostile nesting on every path,the stream parser included
+        auto deep = nested(ParseLimits{}.max_depth + 1);
+        for (auto e: parseAll(deep, {})) CHECK(e == Error::ErrDep);
+        std::istringstream in(deep);
+        Error error;
+        CHECK(BObject::Parse(in, &error) == nullptr && error == Error::ErrDep);
+        //a truncated container still reports ErrEpE from the stream
+        std::istringstream cut("li1eli2e");
+        CHECK(BObject::Parse(cut, &error, limits) == nullptr && error == Error::ErrEpE);
+    }
+
+    void nodeLimit() {
+        ParseLimits limits;
+        limits.max_nodes = 4;
+        for (auto e: parseAll("li1ei2ei3ee", limits)) CHECK(e == Error::NoError);
+        for (auto e: parseAll("li1ei2ei3ei4ee", limits)) CHECK(e == Error::ErrCnt);
+        for (auto e: parseAll("d1:ai1e1:bli2eee", limits)) CHECK(e == Error::NoError);
+        for (auto e: parseAll("d1:ai1e1:bli2ei3eee", limits)) CHECK(e == Error::ErrCnt);
+    }
+
+    //far deeper than any thread stack would take recursively,every walk keeps its own stack
+    void deepNesting() {
+        const size_t depth = 100000;
+        ParseLimits limits;
+        limits.max_depth = depth;
+        for (bool dict: {false, true}) {
+            auto text = nested(depth, dict);
+            Error error;
+            auto doc = Document::Parse(text, &error, nullptr, limits);
+            CHECK(error == Error::NoError);
+            std::ostringstream os;
+            CHECK(doc.Bencode(os) == int(text.size()));
+            CHECK(os.str() == text);
+
+            auto obj = doc.root().to_object();
+            CHECK(obj != nullptr);
+            if (obj) CHECK(check::encode(*obj) == text);
+
+            auto tape = Tape::Parse(text, &error, nullptr, limits);
+            CHECK(error == Error::NoError);
+            auto fromTape = tape.to_object();
+            CHECK(fromTape && check::encode(*fromTape) == text);
+            if (obj) {
+                auto back = Tape::From(*obj, &error);
+                CHECK(error == Error::NoError);
+                CHECK(back.words() == tape.words());
+            }
+
+            auto direct = BObject::Parse(std::string_view(text), &error, nullptr, limits);
+            CHECK(direct && direct->encoded_size() == text.size());
+            auto index = StructuralIndex::Build(text, &error, nullptr, limits);
+            CHECK(error == Error::NoError);
+            auto viaIndex = index.ToObject(&error);
+            CHECK(viaIndex && check::encode(*viaIndex) == text);
+            std::istringstream in(text);
+            auto streamed = BObject::Parse(in, &error, limits);
+            CHECK(error == Error::NoError && streamed && check::encode(*streamed) == text);
+            //the trees are dropped here,which must not recurse either
+        }
+        //to_string() walks with its own stack too,a dict's indent grows with depth so lists are used here
+        std::string text = nested(2 * depth);
+        limits.max_depth = 2 * depth;
+        Error error;
+        auto obj = BObject::Parse(std::string_view(text), &error, nullptr, limits);
+        CHECK(obj != nullptr);
+        if (obj) {
+            auto json = obj->to_string();
+            CHECK(json == std::string(2 * depth, '[') + "1" + std::string(2 * depth, ']'));
+        }
+    }
+}
+
+int main() {
+    depthLimit();
+    nodeLimit();
+    deepNesting();
+    return bencode::check::report("limits_test");
+}
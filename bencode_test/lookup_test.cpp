@@ -0,0 +1,120 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "alloc_count.h"
+#include "check.h"
+#include <stdexcept>
+#include <string>
+
+using namespace bencode;
+
+struct Info {
+    int64_t length = 0;
+    int64_t pieces = 0;
+};
+
+void to_bencode(Bencode &b, const Info &info) {
+    b[std::string("a key well past the small string buffer")] = info.length;
+    b["pieces"] = info.pieces;
+}
+
+void from_bencode(Bencode &b, Info &info) {
+    b["a key well past the small string buffer"].get_to(info.length);
+    b["pieces"].get_to(info.pieces);
+}
+
+namespace {
+    //longer than any small string buffer,a key built from it would allocate
+    const std::string LongKey = "a key well past the small string buffer";
+
+    std::string write(Bencode &b) {
+        std::string out;
+        b.encode_to(out);
+        return out;
+    }
+
+    //selecting a key and reading its value never builds a key
+    void lookupsDontAllocate() {
+        Error error;
+        auto root = BObject::Parse(std::string_view("d39:" + LongKey + "i7e5:shorti1ee"), &error);
+        CHECK(root && root->Dict());
+        if (!root || !root->Dict()) return;
+        Bencode b(root);
+        std::string_view view = LongKey;
+        auto dict = root->Dict();
+        int64_t sum = 0, out = 0;
+
+        auto before = check::allocations;
+        for (int i = 0; i < 100; i++) {
+            sum += b["a key well past the small string buffer"].get<int64_t>();
+            sum += b[view].get<int64_t>();
+            sum += b[LongKey].get<int64_t>();
+            b["short"].get_to(out);
+            sum += out;
+            sum += *dict->find(view)->second->Int();
+            sum += *dict->find("a key well past the small string buffer")->second->Int();
+            sum += *dict->find(LongKey)->second->Int();
+            sum += dict->find("missing") == dict->end();
+        }
+        CHECK(check::allocations == before);
+        CHECK(sum == 100 * (7 * 6 + 1 + 1));
+    }
+
+    //a temporary key is kept,so it can be assigned in a later statement
+    void temporaryKey() {
+        auto root = std::make_shared<BObject>(BObject::DICT{});
+        Bencode b(root);
+        b[std::string(LongKey)];
+        //reuses the memory the temporary had,were it still referenced
+        std::string other(LongKey.size(), 'z');
+        b = int64_t(5);
+        auto it = root->Dict()->find(LongKey);
+        CHECK(root->Dict()->size() == 1 && it != root->Dict()->end());
+        CHECK(it != root->Dict()->end() && *it->second->Int() == 5);
+        CHECK(b[std::string(LongKey)].get<int64_t>() == 5);
+
+        //a nested to_bencode selecting temporary keys of its own leaves the outer key alone
+        b[std::string("info, another key past the buffer")] = Info{3, 4};
+        auto info = root->Dict()->find("info, another key past the buffer");
+        CHECK(info != root->Dict()->end() && info->second->Dict());
+        auto back = b["info, another key past the buffer"].get<Info>();
+        CHECK(back.length == 3 && back.pieces == 4);
+        Error error;
+        auto expect = BObject::Parse(std::string_view("d39:" + LongKey + "i5e33:info, another key past the buffer"
+                                                      "d39:" + LongKey + "i3e6:piecesi4eee"), &error);
+        auto encoded = BObject::Parse(std::string_view(write(b)), &error);
+        CHECK(expect && encoded && check::same(*expect, *encoded));
+    }
+
+    //a borrowed key selected in one statement is copied,the caller may change it before the assignment
+    void borrowedKey() {
+        auto root = std::make_shared<BObject>(BObject::DICT{});
+        Bencode b(root);
+        std::string name = LongKey;
+        b[name];
+        name = "other";
+        name.append(LongKey.size(), 'z');
+        b = int64_t(1);
+        auto it = root->Dict()->find(LongKey);
+        CHECK(root->Dict()->size() == 1 && it != root->Dict()->end() && *it->second->Int() == 1);
+
+        //a key used in its own statement is not kept,a bare assignment then has no key
+        b["used"] = int64_t(2);
+        bool threw = false;
+        try {
+            b = int64_t(3);
+        } catch (std::runtime_error &) {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(b["used"].get<int64_t>() == 2 && root->Dict()->size() == 2);
+    }
+}
+
+int main() {
+    lookupsDontAllocate();
+    temporaryKey();
+    borrowedKey();
+    return bencode::check::report("lookup_test");
+}
@@ -0,0 +1,139 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <sstream>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::encode;
+using bencode::check::same;
+
+namespace {
+    //canonical encodings,dict keys ascending
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i0e",
+            "i-42e",
+            "i9223372036854775807e",
+            "i-9223372036854775808e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "l0:e",
+            "d0:0:e",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    const std::vector<std::string> Broken = {
+            "", "x", ":", "i", "ie", "i-e", "i1", "i03e", "i-0e", "i00e", "i1.5e",
+            "-1:a", "3:ab", "1a", "1", "l", "li1e", "d", "d1:a", "d1:ai1e", "di1ei2ee", "d1:ae",
+    };
+
+    std::shared_ptr<BObject> fromStream(const std::string &text, Error *error) {
+        std::istringstream in(text);
+        return BObject::Parse(in, error);
+    }
+
+    void streamAndBufferAgree() {
+        for (auto &&text: Samples) {
+            Error e1, e2;
+            size_t used = 0;
+            auto a = BObject::Parse(std::string_view(text), &e1, &used);
+            auto b = fromStream(text, &e2);
+            CHECK(e1 == Error::NoError);
+            CHECK(e2 == Error::NoError);
+            if (!a || !b) {
+                std::fprintf(stderr, "  sample %s\n", text.c_str());
+                continue;
+            }
+            CHECK(used == text.size());
+            CHECK(same(*a, *b));
+        }
+        for (auto &&text: Broken) {
+            Error e1, e2;
+            auto a = BObject::Parse(std::string_view(text), &e1);
+            auto b = fromStream(text, &e2);
+            CHECK(!a && e1 != Error::NoError);
+            CHECK(!b && e2 != Error::NoError);
+            if (a || b) std::fprintf(stderr, "  broken sample %s accepted\n", text.c_str());
+        }
+    }
+
+    //every encoder of a BObject produces the same bytes and they parse back to the same tree
+    void encodersRoundTrip() {
+        for (auto &&text: Samples) {
+            Error error;
+            auto obj = BObject::Parse(std::string_view(text), &error);
+            if (!obj) {
+                CHECK(obj != nullptr);
+                continue;
+            }
+            auto bytes = encode(*obj);
+            if (check::sortedDict()) {
+                CHECK(bytes == text);
+            }
+            std::ostringstream os;
+            CHECK(obj->Bencode(os) == int(bytes.size()));
+            CHECK(os.str() == bytes);
+            CHECK(obj->encoded_size() == bytes.size());
+            std::string buf(bytes.size(), '\0');
+            CHECK(obj->encode_to(buf.data(), buf.size()) == int(bytes.size()));
+            CHECK(buf == bytes);
+#ifdef BENCODE_HAS_IOVEC
+            std::vector<iovec> iov;
+            std::string scratch, joined;
+            CHECK(obj->encode_to(iov, scratch, 4) == int(bytes.size()));
+            for (auto &&v: iov) joined.append(static_cast<const char *>(v.iov_base), v.iov_len);
+            CHECK(joined == bytes);
+#endif
+            auto again = BObject::Parse(std::string_view(bytes), &error);
+            CHECK(again && same(*obj, *again));
+        }
+    }
+
+    //"0:" is a valid empty string and must be written back as "0:",not dropped
+    void emptyStrings() {
+        const std::string text = "d1:a0:e";
+        Error error;
+        auto obj = fromStream(text, &error);
+        CHECK(error == Error::NoError && obj);
+        if (obj) {
+            CHECK(encode(*obj) == text);
+            CHECK(obj->encoded_size() == text.size());
+        }
+        CHECK(encode(*fromStream("0:", &error)) == "0:");
+
+        BObject empty(std::string{});
+        std::ostringstream os;
+        CHECK(BObject::EncodeString(os, "") == 2);
+        CHECK(os.str() == "0:");
+        CHECK(encode(empty) == "0:");
+
+        auto doc = Document::Parse(text, &error);
+        std::ostringstream dos;
+        doc.Bencode(dos);
+        CHECK(dos.str() == text);
+
+        auto tape = Tape::Parse(text, &error);
+        std::ostringstream tos;
+        tape.Bencode(tos);
+        CHECK(tos.str() == text);
+
+        Writer w;
+        w.begin_dict().key("a").value(std::string_view()).end();
+        CHECK(w.str() == text);
+    }
+}
+
+int main() {
+    streamAndBufferAgree();
+    encodersRoundTrip();
+    emptyStrings();
+    return bencode::check::report("parse_test");
+}
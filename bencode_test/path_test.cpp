@@ -0,0 +1,141 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "alloc_count.h"
+#include "check.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace bencode;
+
+namespace {
+    const std::string Torrent = "d4:infod5:filesld6:lengthi1e4:pathl1:aeed6:lengthi2e4:pathl1:beed6:lengthi3eee"
+                                "4:name3:abcee";
+
+    std::shared_ptr<BObject> parse(const std::string &text) {
+        Error error;
+        return BObject::Parse(std::string_view(text), &error);
+    }
+
+    template<class Root>
+    std::vector<int64_t> ints(const Path &path, Root &root) {
+        std::vector<int64_t> ret;
+        for (auto node: path.each(root)) {
+            if (auto v = node->Int()) ret.push_back(*v);
+        }
+        return ret;
+    }
+
+    void compile() {
+        for (std::string good: {"", "a", "a.b", "[0]", "a[1].b", "a[*]", "*", "a.*.b", "a\\.b", "a\\[0\\]", "\\*"}) {
+            Error error = Error::ErrIvd;
+            compile_path(good, &error);
+            CHECK(error == Error::NoError);
+        }
+        for (std::string bad: {".", "a.", "a..b", "[]", "[x]", "[-1]", "[1", "a\\", "a[0]b",
+                               "[99999999999999999999999]"}) {
+            Error error = Error::NoError;
+            auto path = compile_path(bad, &error);
+            CHECK(error == Error::ErrIvd);
+            CHECK(path.segments().empty());
+            if (error != Error::ErrIvd) std::fprintf(stderr, "  path %s accepted\n", bad.c_str());
+        }
+        std::string wild = "*";
+        for (size_t i = 1; i < Path::MaxWildcards; i++) wild += ".*";
+        Error error;
+        CHECK(compile_path(wild, &error).has_wildcard() && error == Error::NoError);
+        compile_path(wild + "[*]", &error);
+        CHECK(error == Error::ErrCnt);
+
+        auto path = compile_path("info.files[2].length", &error);
+        CHECK(path.segments().size() == 4 && !path.has_wildcard());
+        CHECK(path.segments()[2].kind == Path::Segment::Kind::Index && path.segments()[2].index == 2);
+        CHECK(path.segments()[1].key == "files");
+    }
+
+    void onObjects() {
+        auto obj = parse(Torrent);
+        CHECK(compile_path("").find(*obj) == obj.get());
+        auto name = compile_path("info.name").find(*obj);
+        CHECK(name && *name->Str() == "abc");
+        auto len = compile_path("info.files[1].length").find(*obj);
+        CHECK(len && *len->Int() == 2);
+        CHECK(compile_path("info.files[3].length").find(*obj) == nullptr);
+        CHECK(compile_path("info.name.x").find(*obj) == nullptr);
+        CHECK(compile_path("info[0]").find(*obj) == nullptr);
+        CHECK(compile_path("missing").find(*obj) == nullptr);
+
+        auto lengths = compile_path("info.files[*].length");
+        CHECK(ints(lengths, *obj) == std::vector<int64_t>({1, 2, 3}));
+        CHECK(*lengths.find(*obj)->Int() == 1);
+        //the third file has no path,the walk goes on past it
+        auto paths = compile_path("info.files[*].path[0]");
+        std::vector<std::string> found;
+        for (auto node: paths.each(*obj)) found.push_back(*node->Str());
+        CHECK(found == std::vector<std::string>({"a", "b"}));
+        CHECK(compile_path("info.files[*].missing").find(*obj) == nullptr);
+        auto none = compile_path("info.name[*]").each(*obj);
+        CHECK(none.begin() == none.end());
+
+        //a dict wildcard visits every value,in the dict's order
+        auto dicts = parse("d1:ad1:xi1ee1:bd1:xi2ee1:cd1:yi3eee");
+        auto xs = ints(compile_path("*.x"), *dicts);
+        std::sort(xs.begin(), xs.end());
+        CHECK(xs == std::vector<int64_t>({1, 2}));
+        auto nested = parse("lld1:xi1eeeld1:xi2eed1:xi3eeee");
+        CHECK(ints(compile_path("[*][*].x"), *nested) == std::vector<int64_t>({1, 2, 3}));
+    }
+
+    //a Document keeps dicts in input order,so wildcard matches come in that order everywhere
+    void onDocuments() {
+        Error error;
+        auto doc = Document::Parse(Torrent, &error);
+        auto name = compile_path("info.name").find(doc);
+        CHECK(name && name->Str() && *name->Str() == "abc");
+        CHECK(ints(compile_path("info.files[*].length"), doc) == std::vector<int64_t>({1, 2, 3}));
+        auto dicts = Document::Parse("d1:bd1:xi2ee1:ad1:xi1eee", &error);
+        CHECK(ints(compile_path("*.x"), dicts) == std::vector<int64_t>({2, 1}));
+        CHECK(compile_path("info.files[5]").find(doc) == nullptr);
+    }
+
+    //'\' takes the next character literally,so keys may hold '.','[' or be "*"
+    void escapes() {
+        auto obj = parse("d1:*i1e3:a.bi2e4:c[0]i3e1:xi4ee");
+        auto star = compile_path("\\*").find(*obj);
+        CHECK(star && *star->Int() == 1);
+        auto dotted = compile_path("a\\.b").find(*obj);
+        CHECK(dotted && *dotted->Int() == 2);
+        auto bracket = compile_path("c\\[0\\]").find(*obj);
+        CHECK(bracket && *bracket->Int() == 3);
+        CHECK(compile_path("*").has_wildcard() && !compile_path("\\*").has_wildcard());
+    }
+
+    //a compiled path walks without touching the heap
+    void noAllocation() {
+        auto obj = parse(Torrent);
+        Error error;
+        auto doc = Document::Parse(Torrent, &error);
+        auto direct = compile_path("info.files[1].length");
+        auto wild = compile_path("info.files[*].length");
+        auto before = check::allocations;
+        int64_t total = 0;
+        for (int i = 0; i < 100; i++) {
+            total += *direct.find(*obj)->Int();
+            for (auto node: wild.each(*obj)) total += *node->Int();
+            for (auto node: wild.each(doc)) total += *node->Int();
+        }
+        CHECK(check::allocations == before);
+        CHECK(total == 100 * (2 + 6 + 6));
+    }
+}
+
+int main() {
+    compile();
+    onObjects();
+    onDocuments();
+    escapes();
+    noAllocation();
+    return bencode::check::report("path_test");
+}
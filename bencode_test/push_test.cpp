@@ -0,0 +1,119 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <vector>
+
+using namespace bencode;
+using bencode::check::same;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i0e",
+            "i-42e",
+            "i9223372036854775807e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "d0:0:e",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    //wrong from the first bad byte on,as opposed to cut short
+    const std::vector<std::string> Broken = {
+            "x", "ie", "i-e", "i03e", "i-0e", "i00e", "i1.5e", "-1:a", "1a", "di1ei2ee", "d1:ae", "l:e",
+    };
+
+    //the input fed in two pieces split at cut,then the tail if Done came early
+    std::shared_ptr<BObject> feedSplit(const std::string &text, size_t cut, Error *error) {
+        PushParser p;
+        size_t used = 0;
+        auto ret = p.feed(std::string_view(text).substr(0, cut), &used);
+        if (ret == Feed::NeedMore) {
+            ret = p.feed(std::string_view(text).substr(cut), &used);
+        }
+        *error = p.error();
+        if (ret != Feed::Done || p.consumed() != text.size()) {
+            return nullptr;
+        }
+        return p.take();
+    }
+
+    void everySplit() {
+        for (auto &&text: Samples) {
+            Error error;
+            auto direct = BObject::Parse(std::string_view(text), &error);
+            CHECK(direct != nullptr);
+            for (size_t cut = 0; cut <= text.size(); cut++) {
+                auto obj = feedSplit(text, cut, &error);
+                CHECK(error == Error::NoError);
+                CHECK(obj && direct && same(*obj, *direct));
+            }
+        }
+    }
+
+    void byteByByte() {
+        std::string text = "d1:ai1e1:bl0:4:spamee";
+        PushParser p;
+        Feed ret = Feed::NeedMore;
+        for (size_t i = 0; i < text.size(); i++) {
+            CHECK(ret == Feed::NeedMore);
+            ret = p.feed(std::string_view(text).substr(i, 1));
+        }
+        CHECK(ret == Feed::Done);
+        auto obj = p.take();
+        Error error;
+        auto direct = BObject::Parse(std::string_view(text), &error);
+        CHECK(obj && direct && same(*obj, *direct));
+        CHECK(p.consumed() == text.size());
+    }
+
+    //the bytes after the value stay with the caller,reset() starts the next one
+    void trailingAndReset() {
+        PushParser p;
+        size_t used = 0;
+        CHECK(p.feed("i1ei2e", &used) == Feed::Done);
+        CHECK(used == 3);
+        auto first = p.take();
+        CHECK(first && first->Int() && *first->Int() == 1);
+        p.reset();
+        CHECK(p.feed("i2e", &used) == Feed::Done);
+        auto second = p.take();
+        CHECK(second && second->Int() && *second->Int() == 2);
+
+        CHECK(p.feed("x") == Feed::Done);//nothing more is taken once Done
+        p.reset();
+        CHECK(p.feed("l") == Feed::NeedMore);
+        CHECK(p.feed("") == Feed::NeedMore);
+        CHECK(p.feed("e") == Feed::Done);
+    }
+
+    void errors() {
+        for (auto &&text: Broken) {
+            PushParser p;
+            CHECK(p.feed(text) == Feed::Failed);
+            CHECK(p.error() != Error::NoError);
+            CHECK(p.feed("e") == Feed::Failed);
+        }
+        PushParser p;
+        p.feed("i0");
+        CHECK(p.feed("3e") == Feed::Failed && p.error() == Error::ErrNum);
+        //a truncated value just waits for more
+        PushParser cut;
+        CHECK(cut.feed("d1:ali1e") == Feed::NeedMore && cut.error() == Error::NoError);
+    }
+}
+
+int main() {
+    everySplit();
+    byteByByte();
+    trailingAndReset();
+    errors();
+    return bencode::check::report("push_test");
+}
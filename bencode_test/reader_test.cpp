@@ -0,0 +1,164 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <vector>
+
+using namespace bencode;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i0e",
+            "i-42e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    const std::vector<std::string> Broken = {
+            "", "x", "i", "ie", "i-e", "i1", "i03e", "i-0e", "i00e",
+            "3:ab", "1", "l", "li1e", "d", "d1:a", "d1:ai1e", "di1ei2ee", "d1:ae",
+    };
+
+    //handler writing every token back out,so a Reader pass can be compared with its input
+    struct Echo {
+        Writer w;
+
+        void on_int(int64_t val) { w.value(val); }
+
+        void on_bigint(std::string_view digits) {
+            BObject big(BigInt::Parse(digits));
+            w.value(big);
+        }
+
+        void on_string(std::string_view str) { w.value(str); }
+
+        void on_key(std::string_view key) { w.key(key); }
+
+        void on_list_begin() { w.begin_list(); }
+
+        void on_list_end() { w.end(); }
+
+        void on_dict_begin() { w.begin_dict(); }
+
+        void on_dict_end() { w.end(); }
+    };
+
+    //same handler without on_bigint
+    struct Small {
+        void on_int(int64_t) {}
+
+        void on_string(std::string_view) {}
+
+        void on_key(std::string_view) {}
+
+        void on_list_begin() {}
+
+        void on_list_end() {}
+
+        void on_dict_begin() {}
+
+        void on_dict_end() {}
+    };
+
+    std::string pull(const std::string &text, Error *error, size_t *used) {
+        Reader r(text);
+        Echo echo;
+        while (r.next()) {
+            switch (r.token()) {
+                case Token::Int:
+                    echo.on_int(r.integer());
+                    break;
+                case Token::BigInt:
+                    echo.on_bigint(r.str());
+                    break;
+                case Token::Str:
+                    echo.on_string(r.str());
+                    break;
+                case Token::Key:
+                    echo.on_key(r.str());
+                    break;
+                case Token::ListBegin:
+                    echo.on_list_begin();
+                    break;
+                case Token::DictBegin:
+                    echo.on_dict_begin();
+                    break;
+                default:
+                    echo.w.end();
+                    break;
+            }
+        }
+        *error = r.error();
+        *used = r.consumed();
+        return r.error() == Error::NoError ? echo.w.take() : std::string();
+    }
+
+    void roundTrip() {
+        for (auto &&text: Samples) {
+            Error error;
+            size_t used = 0;
+            CHECK(pull(text, &error, &used) == text);
+            CHECK(error == Error::NoError && used == text.size());
+
+            Echo echo;
+            CHECK(Reader::Parse(text, echo, &error, &used));
+            CHECK(error == Error::NoError && used == text.size());
+            CHECK(echo.w.str() == text);
+        }
+        //bytes after the value are left alone
+        Error error;
+        size_t used = 0;
+        CHECK(pull("i1eXYZ", &error, &used) == "i1e");
+        CHECK(error == Error::NoError && used == 3);
+    }
+
+    void skip() {
+        Reader r("d1:ald1:xi1ee3:abce1:bi2ee");
+        CHECK(r.next() && r.token() == Token::DictBegin);
+        CHECK(r.next() && r.token() == Token::Key && r.str() == "a");
+        CHECK(r.next() && r.token() == Token::ListBegin && r.depth() == 2);
+        CHECK(r.skip());
+        CHECK(r.depth() == 1);
+        CHECK(r.next() && r.token() == Token::Key && r.str() == "b");
+        CHECK(r.next() && r.token() == Token::Int && r.integer() == 2);
+        CHECK(r.next() && r.token() == Token::DictEnd);
+        CHECK(!r.next() && r.error() == Error::NoError);
+
+        Reader cut("ld1:xi1e");
+        CHECK(cut.next() && cut.skip() == false);
+        CHECK(cut.error() == Error::ErrEpE);
+    }
+
+    void errors() {
+        for (auto &&text: Broken) {
+            Error error;
+            size_t used = 1;
+            pull(text, &error, &used);
+            CHECK(error != Error::NoError);
+            Small small;
+            CHECK(!Reader::Parse(text, small, &error, &used));
+            CHECK(error != Error::NoError && used == 0);
+        }
+        Error error;
+        Small small;
+        CHECK(!Reader::Parse("i03e", small, &error) && error == Error::ErrNum);
+        CHECK(!Reader::Parse("li1e", small, &error) && error == Error::ErrEpE);
+        //without on_bigint an integer outside int64_t is an error
+        CHECK(!Reader::Parse("i123456789012345678901234567890e", small, &error) && error == Error::ErrNum);
+    }
+}
+
+int main() {
+    roundTrip();
+    skip();
+    errors();
+    return bencode::check::report("reader_test");
+}
@@ -0,0 +1,154 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <Symbol.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::same;
+
+namespace {
+    //equal texts share one interned entry,so they share one buffer
+    void interning() {
+        auto before = SymbolTable::global().size();
+        Symbol a("length"), b(std::string("length")), c(std::string_view("length"));
+        CHECK(a.interned() && b.interned() && c.interned());
+        CHECK(a.data() == b.data() && b.data() == c.data());
+        CHECK(a == b && a == "length" && a.str() == "length" && a.size() == 6);
+        CHECK(SymbolTable::global().size() == before + 1);
+        CHECK(std::hash<Symbol>()(a) == std::hash<std::string_view>()("length"));
+
+        Symbol empty;
+        CHECK(empty.empty() && empty == "" && empty == Symbol(""));
+
+        Symbol copy = a, moved = std::move(copy);
+        CHECK(moved == a && copy.empty());
+    }
+
+    //ordering and equality against Symbols and plain text agree with the text
+    void comparisons() {
+        Symbol a("apple"), b("banana");
+        CHECK(a < b && b > a && a != b);
+        CHECK(a < "b" && a == std::string("apple") && a == std::string_view("apple"));
+        CHECK((a <=> Symbol("apple")) == 0);
+        CHECK(Symbol("") < a);
+        //comparing with plain text doesn't intern it
+        auto before = SymbolTable::global().size();
+        CHECK(a != "never interned" && a < "never interned");
+        CHECK(SymbolTable::global().size() == before);
+    }
+
+    //more distinct keys than the table holds,parsed from input:they stop being interned at the
+    //input share,keys named by the program still are,and every lookup keeps working
+    void hostileKeys() {
+        const size_t n = SymbolTable::MaxSymbols + 1000;
+        std::string text = "d";
+        char key[16];
+        for (size_t i = 0; i < n; i++) {
+            std::snprintf(key, sizeof(key), "h%07zu", i);
+            text += "8:" + std::string(key) + "i" + std::to_string(i) + "e";
+        }
+        text += "e";
+        Error error;
+        auto obj = BObject::Parse(std::string_view(text), &error);
+        CHECK(obj && obj->Dict() && obj->Dict()->size() == n);
+        if (!obj || !obj->Dict()) return;
+        for (size_t i: {size_t(0), SymbolTable::MaxInputSymbols, n - 1}) {
+            std::snprintf(key, sizeof(key), "h%07zu", i);
+            auto it = obj->Dict()->find(std::string_view(key));
+            CHECK(it != obj->Dict()->end() && *it->second->Int() == int64_t(i));
+        }
+#ifdef I_KEY
+        CHECK(SymbolTable::global().size() == SymbolTable::MaxInputSymbols);
+        CHECK(!obj->Dict()->find(std::string_view(key))->first.interned());
+#endif
+        CHECK(SymbolTable::global().size() < SymbolTable::MaxSymbols);
+        CHECK(Symbol("named after the flood").interned());
+
+        //a later message still parses and is looked up as usual
+        auto later = BObject::Parse(std::string_view("d6:lengthi1e9:late namei2ee"), &error);
+        CHECK(later && later->Dict()->find("late name") != later->Dict()->end());
+        CHECK(later && *later->Dict()->find("length")->second->Int() == 1);
+    }
+
+    //keys past MaxLength,and any key once the table is full,get a private entry compared by text
+    void limits() {
+        std::string longText(SymbolTable::MaxLength + 1, 'k');
+        Symbol longA(longText), longB(longText);
+        CHECK(!longA.interned() && !longB.interned());
+        CHECK(longA.data() != longB.data());
+        CHECK(longA == longB && longA == longText);
+        CHECK(Symbol(std::string(SymbolTable::MaxLength, 'k')).interned());
+        {
+            Symbol copy = longA;
+            CHECK(copy == longA && copy.data() == longA.data());
+        }
+        CHECK(longA == longText);
+
+        for (size_t i = 0; SymbolTable::global().size() < SymbolTable::MaxSymbols; i++) {
+            Symbol("filler" + std::to_string(i));
+        }
+        CHECK(SymbolTable::global().size() == SymbolTable::MaxSymbols);
+        Symbol late("late key"), again("late key");
+        CHECK(!late.interned() && late == again && late.data() != again.data());
+        CHECK(SymbolTable::global().size() == SymbolTable::MaxSymbols);
+        //keys interned before the table filled up are still found
+        CHECK(Symbol("length").interned());
+
+        //parsing still works past the limits,with keys compared by text
+        std::string text = "d" + std::to_string(longText.size()) + ":" + longText + "i1e8:late keyi2ee";
+        Error error;
+        auto obj = BObject::Parse(std::string_view(text), &error);
+        CHECK(obj && obj->Dict() && obj->Dict()->size() == 2);
+        if (obj && obj->Dict()) {
+            CHECK(obj->Dict()->find(std::string_view(longText)) != obj->Dict()->end());
+            CHECK(obj->Dict()->find("late key") != obj->Dict()->end());
+        }
+    }
+
+    //threads interning the same texts all end up with the same entries
+    void concurrent() {
+        const int threads = 4, keys = 200;
+        std::vector<std::vector<const char *>> seen(threads);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                for (int i = 0; i < keys; i++) {
+                    Symbol s("shared" + std::to_string(i));
+                    seen[t].push_back(s.interned() ? s.data() : nullptr);
+                }
+            });
+        }
+        for (auto &&th: pool) th.join();
+        for (int t = 1; t < threads; t++) {
+            CHECK(seen[t] == seen[0]);
+        }
+    }
+
+    //with I_KEY the dict keys of every parsed tree come from the table
+    void parsedKeys() {
+        Error error;
+        auto a = BObject::Parse(std::string_view("d6:lengthi1ee"), &error);
+        auto b = BObject::Parse(std::string_view("d6:lengthi1ee"), &error);
+        CHECK(a && b && same(*a, *b));
+#ifdef I_KEY
+        if (a && b) {
+            CHECK(a->Dict()->begin()->first.data() == b->Dict()->begin()->first.data());
+        }
+#endif
+    }
+}
+
+int main() {
+    interning();
+    comparisons();
+    concurrent();
+    parsedKeys();
+    hostileKeys();
+    limits();
+    return bencode::check::report("symbol_test");
+}
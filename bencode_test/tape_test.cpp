@@ -0,0 +1,114 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "check.h"
+#include <sstream>
+#include <vector>
+
+using namespace bencode;
+using bencode::check::encode;
+using bencode::check::same;
+
+namespace {
+    const std::vector<std::string> Samples = {
+            "0:",
+            "4:spam",
+            "i-42e",
+            "i123456789012345678901234567890e",
+            "le",
+            "de",
+            "d1:a0:e",
+            "d1:ai1e1:bl0:4:spamee",
+            "d4:infod6:lengthi12e4:name5:a.txt12:piece lengthi262144eee",
+            "lli1eeld1:xleeee",
+    };
+
+    std::string write(const Tape &tape) {
+        std::ostringstream os;
+        tape.Bencode(os);
+        return os.str();
+    }
+
+    //the tape keeps input order,so it writes the input back byte for byte
+    void roundTrip() {
+        for (auto &&text: Samples) {
+            Error error;
+            size_t used = 0;
+            auto tape = Tape::Parse(text, &error, &used);
+            CHECK(error == Error::NoError);
+            CHECK(used == text.size());
+            CHECK(!tape.empty());
+            CHECK(write(tape) == text);
+            auto obj = tape.to_object();
+            auto direct = BObject::Parse(std::string_view(text), &error);
+            CHECK(obj && direct && same(*obj, *direct));
+
+            auto back = Tape::From(*direct, &error);
+            CHECK(error == Error::NoError);
+            CHECK(write(back) == encode(*direct));
+        }
+    }
+
+    void navigation() {
+        Error error;
+        auto tape = Tape::Parse("d5:filesld6:lengthi1eed6:lengthi2eee4:name3:abce", &error);
+        auto root = tape.root();
+        CHECK(root.type() == BType::BDICT);
+        auto dict = root.Dict();
+        CHECK(dict.size() == 2);
+        auto files = dict.find("files");
+        CHECK(files != dict.end());
+        auto list = (*files).second.List();
+        CHECK(list.size() == 2);
+        CHECK(list.at(1).Dict().find("length") != list.at(1).Dict().end());
+        CHECK((*list.at(1).Dict().find("length")).second.Int() == 2);
+        CHECK((*dict.find("name")).second.Str() == "abc");
+        CHECK(dict.find("missing") == dict.end());
+        //next() jumps over the whole list
+        CHECK(TapeRef(&tape, (*files).second.next()).Str() == "name");
+        CHECK(root.Int(&error) == 0 && error == Error::ErrTyp);
+    }
+
+    //a failed parse yields an empty tape that is safe to encode and convert
+    void emptyTape() {
+        for (std::string bad: {"", "xyz", "l", "d1:a", "i03e", "3:ab", "di1ei2ee"}) {
+            Error error;
+            size_t used = 1;
+            auto tape = Tape::Parse(bad, &error, &used);
+            CHECK(error != Error::NoError);
+            CHECK(used == 0);
+            CHECK(tape.empty());
+            std::ostringstream os;
+            CHECK(tape.Bencode(os) == 0);
+            CHECK(os.str().empty());
+            CHECK(tape.to_object() == nullptr);
+        }
+        Tape tape;
+        CHECK(tape.empty() && tape.to_object() == nullptr);
+    }
+
+    void limits() {
+        Error error;
+        ParseLimits shallow;
+        shallow.max_depth = 2;
+        Tape::Parse("llee", &error, nullptr, shallow);
+        CHECK(error == Error::NoError);
+        Tape::Parse("llleee", &error, nullptr, shallow);
+        CHECK(error == Error::ErrDep);
+        ParseLimits few;
+        few.max_nodes = 3;
+        Tape::Parse("li1ei2ee", &error, nullptr, few);
+        CHECK(error == Error::NoError);
+        Tape::Parse("li1ei2ei3ee", &error, nullptr, few);
+        CHECK(error == Error::ErrCnt);
+    }
+}
+
+int main() {
+    roundTrip();
+    navigation();
+    emptyTape();
+    limits();
+    return bencode::check::report("tape_test");
+}
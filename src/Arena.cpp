@@ -0,0 +1,39 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Arena.h"
+#include <algorithm>
+
+void bencode::Arena::grow(size_t bytes) {
+    //double the block size every time so a big document needs only a few blocks
+    size_t size = std::max(bytes, block_size_);
+    if (!blocks_.empty()) {
+        size = std::max(size, blocks_.back().size * 2);
+    }
+    blocks_.push_back({std::make_unique_for_overwrite<char[]>(size), size});
+    cur_ = blocks_.back().data.get();
+    end_ = cur_ + size;
+}
+
+void bencode::Arena::reset() {
+    if (blocks_.empty()) {
+        return;
+    }
+    auto biggest = std::max_element(blocks_.begin(), blocks_.end(), [](const Block &a, const Block &b) {
+        return a.size < b.size;
+    });
+    Block keep = std::move(*biggest);
+    blocks_.clear();
+    blocks_.push_back(std::move(keep));
+    cur_ = blocks_.back().data.get();
+    end_ = cur_ + blocks_.back().size;
+}
+
+size_t bencode::Arena::capacity() const {
+    size_t ret = 0;
+    for (auto &&b: blocks_) {
+        ret += b.size;
+    }
+    return ret;
+}
@@ -0,0 +1,63 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_ARENA_H
+#define TEST_BENCODE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+namespace bencode {
+    //bump allocator for parsed nodes,nothing is freed one by one:
+    //all blocks go away together when the Arena is destroyed,reset() rewinds for reuse
+    class Arena {
+    public:
+        explicit Arena(size_t block_size = 4096) : block_size_(block_size) {}
+
+        Arena(Arena &&) noexcept = default;
+
+        Arena &operator=(Arena &&) noexcept = default;
+
+        void *allocate(size_t bytes, size_t align) {
+            auto p = (reinterpret_cast<uintptr_t>(cur_) + align - 1) & ~(uintptr_t) (align - 1);
+            if (p + bytes > reinterpret_cast<uintptr_t>(end_)) {
+                grow(bytes + align);
+                p = (reinterpret_cast<uintptr_t>(cur_) + align - 1) & ~(uintptr_t) (align - 1);
+            }
+            cur_ = reinterpret_cast<char *>(p + bytes);
+            return reinterpret_cast<void *>(p);
+        }
+
+        //arena memory is never destructed,so only trivially destructible types may live here
+        template<class T>
+        T *allocate_array(size_t n) {
+            static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destructed");
+            if (n == 0) return nullptr;
+            return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+        }
+
+        //drop every allocation but keep the largest block for the next round
+        void reset();
+
+        //total bytes of all blocks currently owned
+        size_t capacity() const;
+
+    private:
+        void grow(size_t bytes);
+
+        struct Block {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+        std::vector<Block> blocks_;
+        char *cur_{};
+        char *end_{};
+        size_t block_size_;
+    };
+}
+
+#endif //TEST_BENCODE_ARENA_H
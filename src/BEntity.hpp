@@ -4,8 +4,12 @@
 
 #pragma once
 #include "BObject.h"
-#include <functional>
+#include <cstddef>
+#include <iterator>
+#include <optional>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
 
 //implement BEntity
 namespace bencode {
@@ -24,6 +28,7 @@ namespace bencode {
 
         BEntity &add(BObject src) {
             list->push_back(std::make_shared<BObject>(std::move(src)));
+            object->mark_dirty();
             return *this;
         }
 
@@ -31,6 +36,18 @@ namespace bencode {
             return object->Bencode(os);
         }
 
+        int encode_to(std::string &out) {
+            return object->encode_to(out);
+        }
+
+        int encode_to(char *buf, size_t cap) {
+            return object->encode_to(buf, cap);
+        }
+
+        size_t encoded_size() {
+            return object->encoded_size();
+        }
+
         friend std::ostream &operator<<(std::ostream &os, const BEntity &entity) {
             entity.object->Bencode(os);
             return os;
@@ -67,13 +84,14 @@ namespace bencode {
                 throw std::bad_alloc();
         }
 
-        BEntity &put(const std::string &key, BObject value) {
+        BEntity &put(std::string_view key, BObject value) {
             if (!dict) {
                 char msg[200];
                 sprintf(msg, "dict nullptr,put GetDict error!\r\n filename %s ,line %d", __FILE__, __LINE__);
                 throw std::runtime_error(msg);
             }
             dict->emplace(key, std::make_shared<BObject>(std::move(value)));
+            object->mark_dirty();
             return *this;
         }
 
@@ -84,12 +102,25 @@ namespace bencode {
                 throw std::runtime_error(msg);
             }
             dict->clear();
+            object->mark_dirty();
         }
 
         int bencode(std::ostream &os) {
             return object->Bencode(os);
         }
 
+        int encode_to(std::string &out) {
+            return object->encode_to(out);
+        }
+
+        int encode_to(char *buf, size_t cap) {
+            return object->encode_to(buf, cap);
+        }
+
+        size_t encoded_size() {
+            return object->encoded_size();
+        }
+
         //得到json格式的字符串，方便查看
         std::string to_string() const{
             return object->to_string();
@@ -114,7 +145,7 @@ namespace bencode {
     template<>
     class BEntity<int> {
         std::shared_ptr <BObject> object;
-        int *val;
+        int64_t *val;
     public:
         BEntity() : object(std::make_shared<BObject>(0)) {
             val = object->Int();
@@ -122,11 +153,11 @@ namespace bencode {
                 throw std::bad_alloc();
         }
 
-        void set(int v) {
+        void set(int64_t v) {
             *val = v;
         }
 
-        int *data() {
+        int64_t *data() {
             return val;
         }
 
@@ -134,12 +165,33 @@ namespace bencode {
             return object->Bencode(os);
         }
 
+        int encode_to(std::string &out) {
+            return object->encode_to(out);
+        }
+
+        int encode_to(char *buf, size_t cap) {
+            return object->encode_to(buf, cap);
+        }
+
+        size_t encoded_size() {
+            return object->encoded_size();
+        }
+
         friend std::ostream &operator<<(std::ostream &os, const BEntity &entity) {
             entity.object->Bencode(os);
             return os;
         }
 
         friend BEntity &operator>>(BEntity &b, int &val) {
+            if (b.val) {
+                val = int(*b.val);
+            } else {
+                perror(Error::ErrIvd, "val nullptr!");
+            }
+            return b;
+        }
+
+        friend BEntity &operator>>(BEntity &b, int64_t &val) {
             if (b.val) {
                 val = *b.val;
             } else {
@@ -148,7 +200,7 @@ namespace bencode {
             return b;
         }
 
-        friend BEntity &operator<<(BEntity &b, int val) {
+        friend BEntity &operator<<(BEntity &b, int64_t val) {
             if (b.val) {
                 *b.val = val;
             } else {
@@ -191,6 +243,18 @@ namespace bencode {
             return object->Bencode(os);
         }
 
+        int encode_to(std::string &out) {
+            return object->encode_to(out);
+        }
+
+        int encode_to(char *buf, size_t cap) {
+            return object->encode_to(buf, cap);
+        }
+
+        size_t encoded_size() {
+            return object->encoded_size();
+        }
+
         friend BEntity &operator<<(BEntity &b, std::string str) {
             if (b.val) {
                 *b.val = std::move(str);
@@ -241,77 +305,32 @@ namespace bencode {
     class Bencode {
         BEntity<DICT> m_dict;
         std::shared_ptr<BObject> m_list; //用于提供append和at(index).value()的服务
-        std::string cur_key;
+        std::string_view cur_key; //a view of the operator[] argument,so selecting a key never allocates
+        std::string owned_key; //a key kept past its statement by Field,cur_key points at it
 
     public:
         Bencode() = default;
         //为了直接BObject转为Bencode类
         explicit Bencode(std::shared_ptr<BObject>const& bObject):m_dict(bObject){}
-        //putMap && putVector
+        //putMap && putVector,the rvalue overloads move strings and nested containers into the tree
         template<class T>
         void putMap(BObject &dest, const __DICT__<std::string, T> &src) {
-            auto dict = dest.Dict();
-            if (!dict) {
-                char msg[200];
-                sprintf(msg, "object change GetDict error in putMap\r\n filename %s ,line %d", __FILE__, __LINE__);
-                throw std::runtime_error(msg);
-            }
-            for (auto&&[k, v]: src) {
-                BObject obj;
-                if constexpr(isBasicType<T>::value) {
-                    obj = BObject(v);
-                } else if constexpr(isMap<T>::value) {
-                    obj = std::move(DICT());
-                    putMap(obj, v);
-                } else if constexpr(isVector<T>::value) {
-                    obj = std::move(LIST());
-                    putVector(obj, v);
-                } else if constexpr(!isBasicType<T>::value) {// 自定义类型情况，说明当前的哈希表value值是一个dict需要替换成这个dict然后再调用get函数即可
-                    obj = std::move(DICT());
-                    auto new_dict = GetDict(obj);
-
-                    auto pre_dict = m_dict.dict;
-                    auto pre_key = cur_key;
+            putEntries<T>(dest, src);
+        }
 
-                    m_dict.dict = new_dict;
-                    to_bencode(*this, v);
-                    m_dict.dict = pre_dict;
-                    cur_key = pre_key;
-                }
-                dict->emplace(k, std::make_shared<BObject>(std::move(obj)));
-            }
+        template<class T>
+        void putMap(BObject &dest, __DICT__<std::string, T> &&src) {
+            putEntries<T>(dest, std::move(src));
         }
 
         template<class T>
         void putVector(BObject &dest, const std::vector<T> &src) {
-            auto list = dest.List();
-            if (!list) {
-                char msg[200];
-                sprintf(msg, "object change GetList error in putVector\r\n filename %s ,line %d", __FILE__, __LINE__);
-                throw std::runtime_error(msg);
-            }
-            for (auto &&v: src) {
-                BObject obj;
-                if constexpr(isBasicType<T>::value) {
-                    obj = BObject(v);
-                } else if constexpr(isMap<T>::value) {
-                    obj = std::move(DICT());
-                    putMap(obj, v);
-                } else if constexpr(isVector<T>::value) {
-                    obj = std::move(LIST ());
-                    putVector(obj, v);
-                } else if constexpr(!isBasicType<T>::value) {// 自定义类型情况，和getMap唯一的不同在于不需要维护之前的cur_key字段了
-                    obj = std::move(DICT ());
-                    auto new_dict = GetDict(obj);
-
-                    auto pre_dict = m_dict.dict;
+            putElements<T>(dest, src);
+        }
 
-                    m_dict.dict = new_dict;
-                    to_bencode(*this, v);
-                    m_dict.dict = pre_dict;
-                }
-                list-> emplace_back(std::make_shared<BObject>(std::move(obj)));
-            }
+        template<class T>
+        void putVector(BObject &dest, std::vector<T> &&src) {
+            putElements<T>(dest, std::move(src));
         }
 
         static DICT *GetDict(BObject &src) {
@@ -338,152 +357,340 @@ namespace bencode {
 #define APPEND_NAME "LIST"
 #define NULL_ERROR(op,type) throw std::runtime_error(#op"() error at:"#type" nullptr");
 
-        //implement append()
-        template<class T>
-        Bencode& append(const T &src) {
+    private:
+        //an element of src,an rvalue when src is one so it can be moved from
+        template<class Src, class T>
+        using ElementRef = std::conditional_t<std::is_lvalue_reference_v<Src>, const T &, T &&>;
+
+        //node for one value of type T,built by moving out of src when it is an rvalue
+        template<class T, class Src>
+        BObject makeObject(Src &&src) {
+            if constexpr(isBasicType<T>::value) {
+                return BObject(std::forward<Src>(src));
+            } else if constexpr(isVector<T>::value) {
+                BObject obj(LIST{});
+                putVector(obj, std::forward<Src>(src));
+                return obj;
+            } else if constexpr(isMap<T>::value) {
+                BObject obj(DICT{});
+                putMap(obj, std::forward<Src>(src));
+                return obj;
+            } else {// 自定义类型，走外界的to_bencode递归，需要生成一个新的dict来添加元素
+                BObject obj(DICT{});
+                auto pre_dict = m_dict.dict;
+                auto pre_key = cur_key;
+                auto pre_owned = ownsKey() ? std::optional<std::string>(std::move(owned_key)) : std::nullopt;
+                m_dict.dict = GetDict(obj);
+                to_bencode(*this, src);
+                m_dict.dict = pre_dict;
+                if (pre_owned) {
+                    owned_key = std::move(*pre_owned);
+                    pre_key = owned_key;
+                }
+                cur_key = pre_key;
+                return obj;
+            }
+        }
+
+        template<class T, class Src>
+        void putEntries(BObject &dest, Src &&src) {
+            auto dict = dest.Dict();
+            if (!dict) {
+                char msg[200];
+                sprintf(msg, "object change GetDict error in putMap\r\n filename %s ,line %d", __FILE__, __LINE__);
+                throw std::runtime_error(msg);
+            }
+            for (auto&&[k, v]: src) {
+                dict->emplace(k, std::make_shared<BObject>(makeObject<T>(static_cast<ElementRef<Src, T>>(v))));
+            }
+        }
+
+        template<class T, class Src>
+        void putElements(BObject &dest, Src &&src) {
+            auto list = dest.List();
+            if (!list) {
+                char msg[200];
+                sprintf(msg, "object change GetList error in putVector\r\n filename %s ,line %d", __FILE__, __LINE__);
+                throw std::runtime_error(msg);
+            }
+            list->reserve(list->size() + src.size());
+            for (auto &&v: src) {
+                list->emplace_back(std::make_shared<BObject>(makeObject<T>(static_cast<ElementRef<Src, T>>(v))));
+            }
+        }
+
+        //the LIST behind append()/at(),created on first use
+        LIST *appendList() {
             if (!m_dict.dict) {
                 NULL_ERROR(append, GetDict)
             }
             if (!m_list) { //如果缓存的list为空则进行初始化
                 m_list = std::make_shared<BObject>(LIST());
                 m_dict.dict->insert(std::make_pair(APPEND_NAME, m_list));
+                m_dict.object->mark_dirty();
             }
+            return GetList(*m_list);
+        }
 
-            auto *pList = GetList(*m_list);  //得到用于操作的vector
-
-            auto bobj = std::make_shared<BObject>(); //此次需要append到LIST的值
-            auto &obj = *bobj;
-
-            //元模板操作
-            if constexpr(isBasicType<T>::value) {// 如果是基本类型直接走简单逻辑赋值
-                obj = std::move(BObject(src));
-            } else if constexpr(isVector<T>::value) {
-                obj = std::move(LIST ());
-                putVector(obj, src);
-            } else if constexpr(isMap<T>::value) {
-                obj = std::move(DICT ());
-                putMap(obj, src);
-            } else if constexpr(!isBasicType<T>::value) {// 如果是外界的复合类型，则走外界函数逻辑产生递归效果，并且注意需要生成一个新的dict来添加元素！
-                obj = std::move(DICT ());
-                auto new_dict = GetDict(obj);
+        //the LIST behind append() for reading,throws if nothing was appended
+        LIST *appendedList() {
+            if (!m_dict.dict) {
+                NULL_ERROR(at, GetList)
+            }
+            if (!m_list) { //初始化方便缓存，后续就不需要再通过查询方式来更新了
+                auto iter = m_dict.dict->find(APPEND_NAME);
+                if (iter == m_dict.dict->end()) {
+                    throw std::runtime_error("no List exist!!");
+                }
+                m_list = iter->second; //存下一份LIST的智能指针
+            }
+            return GetList(*m_list);
+        }
 
-                auto old_dict = m_dict.dict;
+        //an element of the appended LIST as T
+        template<class T>
+        T elementValue(BObject &src) {
+            //如果是built-in(内建类型)，则直接调用BObject的value方法进行解析
+            if constexpr(isBasicType<T>::value || isVector<T>::value || isMap<T>::value) {
+                return src.value<T>();
+            } else { //自定义类型的解析处理，直接转dict然后再替换Bencode的dict
+                auto *new_dict = GetDict(src);
+                auto *old_dict = m_dict.dict;
                 m_dict.dict = new_dict;
-                to_bencode(*this, src);
+                T ret_value;
+                from_bencode(*this, ret_value);
                 m_dict.dict = old_dict;
+                return ret_value;
             }
-            //这里只需要更新LIST字段对应的BOject即可
-            pList-> emplace_back(bobj);
+        }
+
+        template<class T, class Src>
+        Bencode &appendValue(Src &&src) {
+            auto *pList = appendList();  //先建好LIST，to_bencode里的append也会加到这里
+            auto obj = makeObject<T>(std::forward<Src>(src));
+            pList->emplace_back(std::make_shared<BObject>(std::move(obj)));
+            m_list->mark_dirty();
             return *this;
         }
-        Bencode& append(const char* src){
-            if (!m_dict.dict) {
-                NULL_ERROR(append, GetDict)
+
+        template<class T, class Src>
+        Bencode &assignValue(Src &&src) {
+            if (cur_key.empty()) {
+                char msg[200];
+                sprintf(msg, "operator= valid because of key empty!\r\n filename %s ,line %d", __FILE__, __LINE__);
+                throw std::runtime_error(msg);
             }
-            if (!m_list) { //如果缓存的list为空则进行初始化
-                m_list = std::make_shared<BObject>(LIST ());
-                m_dict.dict->insert(std::make_pair(APPEND_NAME, m_list));
+            auto obj = makeObject<T>(std::forward<Src>(src));
+            m_dict.put(cur_key, std::move(obj));
+            return *this;
+        }
+
+        //value of a basic type,with take a string is moved out and the node is left empty
+        template<class T>
+        static T basicValue(BObject &src, bool take) {
+            if constexpr(isString<T>::value) {
+                if (auto str = src.Str(); str && take) {
+                    T ret = std::move(*str);
+                    str->clear();
+                    src.mark_dirty();
+                    return ret;
+                }
             }
+            return T(src);
+        }
 
-            auto *pList = GetList(*m_list);  //得到用于操作的vector
+        //cur_key refers to owned_key rather than to the caller's text
+        bool ownsKey() const {
+            return cur_key.data() == owned_key.data() && !owned_key.empty();
+        }
 
-            auto bobj = std::make_shared<BObject>(); //此次需要append到LIST的值
-            auto &obj = *bobj;
+        //copies a selected key so b = v in a later statement finds it
+        void keepKey(std::string_view key) {
+            owned_key.assign(key);
+            cur_key = owned_key;
+        }
 
-            obj = std::move(BObject(src));
-            pList->emplace_back(bobj);
-            return *this;
+    public:
+
+        //implement append()
+        template<class T>
+        Bencode& append(const T &src) {
+            return appendValue<T>(src);
+        }
+
+        //moves strings and containers into the LIST
+        template<class T, std::enable_if_t<!std::is_lvalue_reference_v<T>, int> = 0>
+        Bencode &append(T &&src) {
+            return appendValue<T>(std::move(src));
+        }
+
+        Bencode& append(const char* src){
+            return appendValue<const char *>(src);
         }
 
 /**
  * example:
  *      Bencode b;\n
  *      b.append(1).append(2).append("dsafds");\n
- *      b.at(0)<int>.value();\n
+ *      b.at<int>(0).value();\n
+ *      for (int v: b.values<int>()) ...\n
  *
  */
-        //to help use lamda express
+        //an element of the appended LIST,converted when value() is called.it points into the
+        //LIST,so it is valid until that element is removed
         template<class T>
         struct BValue {
-            explicit BValue(std::function<T()> v) : value(std::move(v)) {}
+            BValue(Bencode *owner, BObject *src) : owner(owner), src(src) {}
+
+            T value() const {
+                return owner->elementValue<T>(*src);
+            }
+
+            Bencode *owner;
+            BObject *src;
+        };
+
+        //every element of the appended LIST as T,in order
+        template<class T>
+        class Values {
+        public:
+            class iterator {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using difference_type = std::ptrdiff_t;
+                using value_type = T;
+                using pointer = void;
+                using reference = T;
+
+                iterator() = default;
+
+                iterator(Bencode *owner, LIST::iterator it) : owner_(owner), it_(it) {}
+
+                T operator*() const { return owner_->elementValue<T>(**it_); }
+
+                iterator &operator++() {
+                    ++it_;
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    auto pre = *this;
+                    ++it_;
+                    return pre;
+                }
+
+                bool operator==(const iterator &o) const { return it_ == o.it_; }
 
-            std::function<T()> value;
+                bool operator!=(const iterator &o) const { return it_ != o.it_; }
+
+            private:
+                Bencode *owner_{};
+                LIST::iterator it_{};
+            };
+
+            Values(Bencode *owner, LIST *list) : owner_(owner), list_(list) {}
+
+            iterator begin() const { return {owner_, list_->begin()}; }
+
+            iterator end() const { return {owner_, list_->end()}; }
+
+            size_t size() const { return list_->size(); }
+
+            bool empty() const { return list_->empty(); }
+
+        private:
+            Bencode *owner_;
+            LIST *list_;
         };
 
         // obtain object by index and use value() to get element
         template<class T>
         BValue<T> at(size_t index) {
-            if (!m_dict.dict) {
-                NULL_ERROR(at, GetList)
-            }
-            if (!m_list) { //初始化方便缓存，后续就不需要再通过查询方式来更新了
-                auto iter = m_dict.dict->find(APPEND_NAME);
-                if (iter == m_dict.dict->end()) {
-                    throw std::runtime_error("no List exist!!");
+            return {this, appendedList()->at(index).get()};
+        }
+
+        template<class T>
+        Values<T> values() {
+            return {this, appendedList()};
+        }
+
+        //what operator[] returns.the key is only viewed while the statement that selected it runs,
+        //so b[key] = v and b[key].get<T>() never copy it.a key selected and not used in the same
+        //statement,as in b[name]; name = "other"; b = 1;,is copied into the Bencode when the
+        //Field goes away,and a used one leaves no key selected behind
+        class Field {
+        public:
+            Field(Bencode &owner, std::string_view key) : owner_(owner), key_(key) {}
+
+            Field(const Field &) = delete;
+
+            Field &operator=(const Field &) = delete;
+
+            ~Field() {
+                if (used_) {
+                    owner_.cur_key = {};
+                } else {
+                    owner_.keepKey(key_);
                 }
-                m_list = iter->second; //存下一份LIST的智能指针
             }
-            auto *list = GetList(*m_list);
-            auto obj_src = list->at(index); //得到需要解析的目标资源
-
-            //返回一个lamda表达式进行值的获取，这里的obj_src必须用值捕获到一份拷贝，才不会死掉
-            return BValue<T>([src = obj_src,this]() -> T {
-                //如果是built-in(内建类型)，则直接调用BObject的value方法进行解析
-                if constexpr(isBasicType<T>::value || isVector<T>::value || isMap<T>::value) {
-                    return src->value<T>();
-                } else { //自定义类型的解析处理，直接转dict然后再替换Bencode的dict
-                    auto *new_dict = GetDict(*src);
-                    auto *old_dict = m_dict.dict;
-                    m_dict.dict = new_dict;
-                    T ret_value;
-                    from_bencode(*this, ret_value);
-                    m_dict.dict = old_dict;
-                    return ret_value;
-                }
-            });
-        }
 
-        Bencode &operator[](const std::string &key) {
-            cur_key = key;
-            return *this;
+            template<class T>
+            Bencode &operator=(const T &src) {
+                return select().template assignValue<T>(src);
+            }
+
+            template<class T, std::enable_if_t<!std::is_lvalue_reference_v<T>, int> = 0>
+            Bencode &operator=(T &&src) {
+                return select().template assignValue<T>(std::move(src));
+            }
+
+            template<class T>
+            void get_to(T &dest) {
+                select().get_to(dest);
+            }
+
+            template<class T>
+            T get() {
+                return select().template get<T>();
+            }
+
+            template<class T>
+            T take() {
+                return select().template take<T>();
+            }
+
+        private:
+            Bencode &select() {
+                used_ = true;
+                owner_.cur_key = key_;
+                return owner_;
+            }
+
+            Bencode &owner_;
+            std::string_view key_;
+            bool used_ = false;
+        };
+
+        Field operator[](std::string_view key) {
+            return {*this, key};
         }
 
         //operator =
         template<class T>
         Bencode &operator=(const T &src) {
-            if (cur_key.empty()) {
-                char msg[200];
-                sprintf(msg, "operator= valid because of key empty!\r\n filename %s ,line %d", __FILE__, __LINE__);
-                throw std::runtime_error(msg);
-            }
-            BObject obj;
-            if constexpr(isBasicType<T>::value) {// 如果是基本类型直接走简单逻辑赋值
-                obj = std::move(BObject(src));
-            } else if constexpr(isVector<T>::value) {
-                obj = std::move(LIST ());
-                putVector(obj, src);
-            } else if constexpr(isMap<T>::value) {
-                obj = std::move(DICT ());
-                putMap(obj, src);
-            } else if constexpr(!isBasicType<T>::value) {// 如果是外界的复合类型，则走外界函数逻辑产生递归效果，并且注意需要生成一个新的dict来添加元素！
-                std::string pre_key = cur_key;
-                obj = std::move(DICT ());
-                auto new_dict = GetDict(obj);
-
-                auto old_dict = m_dict.dict;
-                m_dict.dict = new_dict;
-                to_bencode(*this, src);
-                m_dict.dict = old_dict;
-                cur_key = pre_key;
-            }
-            m_dict.put(cur_key, std::move(obj));
-            return *this;
+            return assignValue<T>(src);
+        }
+
+        //moves strings and containers into the tree
+        template<class T, std::enable_if_t<!std::is_lvalue_reference_v<T>, int> = 0>
+        Bencode &operator=(T &&src) {
+            return assignValue<T>(std::move(src));
         }
 
 
-        // getMap && getVector
+        // getMap && getVector,with take strings are moved out of src instead of copied
         template<class T>
-        void getMap(__DICT__<std::string, T> &obj, BObject &src) {
+        void getMap(__DICT__<std::string, T> &obj, BObject &src, bool take = false) {
             Error error;
             auto dict = src.Dict(&error);
             if (dict == nullptr) {
@@ -501,11 +708,11 @@ namespace bencode {
                 T tmp;
                 BObject &m_data = *v;
                 if constexpr(isBasicType<T>::value) {
-                    tmp = T(m_data);
+                    tmp = basicValue<T>(m_data, take);
                 } else if constexpr(isMap<T>::value) {
-                    getMap(tmp, m_data);
+                    getMap(tmp, m_data, take);
                 } else if constexpr(isVector<T>::value) {
-                    getVector(tmp, m_data);
+                    getVector(tmp, m_data, take);
                 } else if constexpr(!isBasicType<T>::value) {// 自定义类型情况，说明当前的哈希表value值是一个dict需要替换成这个dict然后再调用get函数即可
                     auto new_dict = GetDict(m_data);
                     auto pre = m_dict.dict;
@@ -518,7 +725,7 @@ namespace bencode {
         }
 
         template<class T>
-        void getVector(std::vector<T> &obj, BObject &src) {
+        void getVector(std::vector<T> &obj, BObject &src, bool take = false) {
             Error error;
             auto list = src.List(&error);
             if (list == nullptr) {
@@ -526,6 +733,7 @@ namespace bencode {
                 sprintf(msg, "getVector failed!\r\n filename %s ,line %d", __FILE__, __LINE__);
                 throw std::runtime_error(msg);
             }
+            obj.reserve(obj.size() + list->size());
             for (auto &&v: *list) {
                 if (!v) {
                     char msg[200];
@@ -535,11 +743,11 @@ namespace bencode {
                 BObject &m_data = *v;
                 T tmp;
                 if constexpr(isBasicType<T>::value) {
-                    tmp = T(m_data);
+                    tmp = basicValue<T>(m_data, take);
                 } else if constexpr(isMap<T>::value) {
-                    getMap(tmp, m_data);
+                    getMap(tmp, m_data, take);
                 } else if constexpr(isVector<T>::value) {
-                    getVector(tmp, m_data);
+                    getVector(tmp, m_data, take);
                 } else {// 自定义类型情况
                     auto new_dict = GetDict(m_data);
                     auto pre = m_dict.dict;
@@ -559,6 +767,18 @@ namespace bencode {
 
         template<class T>
         T get() {
+            return getValue<T>(false);
+        }
+
+        //like get<T>() but moves strings out of the parsed nodes,which are left holding empty strings
+        template<class T>
+        T take() {
+            return getValue<T>(true);
+        }
+
+    private:
+        template<class T>
+        T getValue(bool take) {
             if (!m_dict.dict) {
                 char msg[200];
                 sprintf(msg, "nullptr Exception!\r\n filename %s ,line %d", __FILE__, __LINE__);
@@ -569,11 +789,11 @@ namespace bencode {
             if (it != m_dict.dict->end()) {
                 BObject &object = *it->second;
                 if constexpr(isMap<T>::value) {
-                    getMap(ret, object);
+                    getMap(ret, object, take);
                 } else if constexpr(isVector<T>::value) {
-                    getVector(ret, object);
+                    getVector(ret, object, take);
                 } else if constexpr(isBasicType<T>::value) {
-                    ret = T(object);
+                    ret = basicValue<T>(object, take);
                 } else if constexpr(!isBasicType<T>::value) {// 如果是自定义类型，则说明此时object是一个dict，然后更改遍历的dict递归即可
                     auto new_dict = GetDict(object);
                     auto pre = m_dict.dict;
@@ -588,7 +808,7 @@ namespace bencode {
             return ret;
         }
 
-
+    public:
         // overload operator<<
         template<class T>
         friend Bencode &operator<<(Bencode &bencode, const T &src) {
@@ -629,6 +849,13 @@ namespace bencode {
             return bencode;
         }
 
+        friend Bencode &operator<<(Bencode &bencode, const int64_t &src) {
+            bencode.m_dict.clear();
+            BObject integer = BObject(src);
+            bencode.m_dict.put("INT", integer);
+            return bencode;
+        }
+
         friend Bencode &operator<<(Bencode &bencode, const char *src) {
             bencode.m_dict.clear();
             BObject str = BObject(src);
@@ -699,6 +926,22 @@ namespace bencode {
             return bencode;
         }
 
+        friend Bencode &operator>>(Bencode &bencode, int64_t &dest) {
+            auto dict = bencode.m_dict.dict;
+            if (dict) {
+                auto ret = dict->find("INT");
+                if (ret != dict->end()) {
+                    BObject &p = *ret->second;
+                    dest = int64_t(p);
+                } else {
+                    perror(Error::ErrTyp, "not find Int can convert!");
+                }
+            } else {
+                perror(Error::ErrIvd, "at convert to Int ,GetDict is nullptr!");
+            }
+            return bencode;
+        }
+
 
         // overload stream operator<< and operator>>
         friend std::ostream &operator<<(std::ostream &os, Bencode &bencode) {
@@ -723,6 +966,31 @@ namespace bencode {
             return is;
         }
 
+        //encoded bytes without iostreams,e.g. for a reply that goes straight to send()
+        int encode_to(std::string &out) {
+            return m_dict.encode_to(out);
+        }
+
+        int encode_to(char *buf, size_t cap) {
+            return m_dict.encode_to(buf, cap);
+        }
+
+        //exact size of the encoding,e.g. to size a frame before encode_to(buf,cap)
+        size_t encoded_size() {
+            return m_dict.encoded_size();
+        }
+
+        //see BObject::cache_encoding
+        void cache_encoding(bool on = true) {
+            m_dict.object->cache_encoding(on);
+        }
+
+#ifdef BENCODE_HAS_IOVEC
+        int encode_to(std::vector<iovec> &iov, std::string &scratch, size_t min_ref = BObject::GatherMinRef) {
+            return m_dict.object->encode_to(iov, scratch, min_ref);
+        }
+#endif
+
         //TODO 加一个to_string方便随时转string进行收发
         std::string to_string(){
             return m_dict.to_string();
@@ -4,8 +4,14 @@
 
 #include "BObject.h"
 #include "BEntity.hpp"
+#include "Reader.h"
+#include "IntCodec.h"
 #include <sstream>
 #include <iostream>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
 
 using std::string;
 using bencode::BObject;
@@ -20,7 +26,7 @@ bencode::BObject::operator std::string() {
     return *str;
 }
 
-bencode::BObject::operator int() {
+bencode::BObject::operator int64_t() {
     Error error;
     auto val = Int(&error);
     if (!val) {
@@ -32,165 +38,623 @@ bencode::BObject::operator int() {
 
 
 std::string *bencode::BObject::Str(Error *error_code) {
-    if (this->type_ != BType::BSTR) {
+    if (tag_ != Tag::Str) {
         if (error_code)*error_code = Error::ErrTyp;
         return nullptr;
     }
     if (error_code)*error_code = Error::NoError;
-    return get_if<string>(&this->value_);
+    return str_;
 }
 
-int *bencode::BObject::Int(Error *error_code) {
-    if (this->type_ != BType::BINT) {
-        if (error_code)*error_code = Error::ErrTyp;
+int64_t *bencode::BObject::Int(Error *error_code) {
+    if (tag_ != Tag::Int) {
+        if (error_code)*error_code = tag_ == Tag::BigInt ? Error::ErrNum : Error::ErrTyp;
         return nullptr;
     }
     if (error_code)*error_code = Error::NoError;
-    return get_if<int>(&this->value_);
+    return &int_;
+}
+
+bencode::BigInt bencode::BObject::as_bigint(Error *error_code) {
+    if (type() != BType::BINT) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    if (tag_ == Tag::BigInt) {
+        return *big_;
+    }
+    return BigInt(int_);
+}
+
+std::string bencode::BObject::raw_digits(Error *error_code) {
+    if (type() != BType::BINT) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    if (tag_ == Tag::BigInt) {
+        return string(big_->digits());
+    }
+    return std::to_string(int_);
 }
 
 BObject::LIST *bencode::BObject::List(Error *error_code) {
-    if (this->type_ != BType::BLIST) {
+    if (tag_ != Tag::List) {
         if (error_code)*error_code = Error::ErrTyp;
         return nullptr;
     }
     if (error_code)*error_code = Error::NoError;
-    return get_if<LIST>(&this->value_);
+    return list_;
 }
 
 BObject::DICT *bencode::BObject::Dict(Error *error_code) {
-    if (this->type_ != BType::BDICT) {
+    if (tag_ != Tag::Dict) {
         if (error_code)*error_code = Error::ErrTyp;
         return nullptr;
     }
     if (error_code)*error_code = Error::NoError;
-    return get_if<DICT>(&this->value_);
+    return dict_;
 }
 
-//recursive descent bencode
-int bencode::BObject::Bencode(std::ostream &os) {
+//iterative bencode,an explicit stack of open containers replaces the recursion
+namespace {
+    //byte sinks for BObject::encodeWith,the string and buffer ones never touch iostreams
+    struct StreamOut {
+        std::ostream &os;
+
+        void put(char c) { os.put(c); }
+
+        void write(const char *p, size_t n) { os.write(p, std::streamsize(n)); }
+
+        void ref(const char *p, size_t n) { write(p, n); }
+    };
+
+    struct StringOut {
+        std::string &out;
+
+        void put(char c) { out.push_back(c); }
+
+        void write(const char *p, size_t n) { out.append(p, n); }
+
+        void ref(const char *p, size_t n) { write(p, n); }
+    };
+
+    //copies what fits into buf,keeps counting past the end like snprintf
+    struct BufferOut {
+        char *buf;
+        size_t cap;
+        size_t len = 0;
+
+        void put(char c) {
+            if (len < cap) buf[len] = c;
+            len++;
+        }
+
+        void write(const char *p, size_t n) {
+            if (len < cap) memcpy(buf + len, p, std::min(n, cap - len));
+            len += n;
+        }
+
+        void ref(const char *p, size_t n) { write(p, n); }
+    };
+
+    //only counts,backs encoded_size()
+    struct CountOut {
+        size_t len = 0;
+
+        void put(char) { len++; }
+
+        void write(const char *, size_t n) { len += n; }
+
+        void ref(const char *, size_t n) { len += n; }
+    };
+
+#ifdef BENCODE_HAS_IOVEC
+    //small pieces go to scratch,long payloads are referenced in place.scratch may reallocate
+    //while the walk runs,so its entries hold offsets until finish() turns them into pointers
+    struct GatherOut {
+        std::vector<iovec> &iov;
+        std::string &scratch;
+        size_t min_ref;
+        std::vector<size_t> pending{};
+        bool last_scratch = false;
+
+        void put(char c) { write(&c, 1); }
+
+        void write(const char *p, size_t n) {
+            if (!last_scratch) {
+                pending.push_back(iov.size());
+                iov.push_back({reinterpret_cast<void *>(scratch.size()), 0});
+                last_scratch = true;
+            }
+            scratch.append(p, n);
+            iov.back().iov_len += n;
+        }
+
+        void ref(const char *p, size_t n) {
+            if (n < min_ref) {
+                write(p, n);
+                return;
+            }
+            iov.push_back({const_cast<char *>(p), n});
+            last_scratch = false;
+        }
+
+        void finish() {
+            for (auto i: pending) {
+                iov[i].iov_base = scratch.data() + reinterpret_cast<size_t>(iov[i].iov_base);
+            }
+        }
+    };
+#endif
+
+    template<class Out>
+    int putString(Out &out, std::string_view val) {
+        char buf[24];
+        auto len = bencode::FormatInt(buf, int64_t(val.size()));
+        buf[len++] = ':';
+        out.write(buf, len);
+        out.ref(val.data(), val.size());
+        return int(len + val.size());
+    }
+
+    template<class Out>
+    int putInt(Out &out, int64_t val) {
+        char buf[22];
+        buf[0] = 'i';
+        auto len = 1 + bencode::FormatInt(buf + 1, val);
+        buf[len++] = 'e';
+        out.write(buf, len);
+        return int(len);
+    }
+
+    //sizes come from the digit count,nothing is formatted
+    int putString(CountOut &out, std::string_view val) {
+        auto len = bencode::UintLength(val.size()) + 1 + val.size();
+        out.len += len;
+        return int(len);
+    }
+
+    int putInt(CountOut &out, int64_t val) {
+        auto len = bencode::IntLength(val) + 2;
+        out.len += len;
+        return len;
+    }
+}
+
+namespace {
+    std::atomic<uint64_t> CacheHits{0};
+    std::atomic<uint64_t> CacheMisses{0};
+    //nested refills of stored containers,deeper ones are encoded inline
+    constexpr size_t MaxCacheDepth = 32;
+}
+
+//iterative walk shared by Bencode,encode_to and encoded_size,Out decides where the bytes go
+template<class Out>
+int bencode::BObject::encodeWith(Out &out, size_t depth, bool useCache) {
     int wLen = 0;
-    if (!os) {
-        return wLen;
-    }
-    void *val;
-    switch (this->type_) {
-        case BType::BSTR:
-            val = this->Str();
-            if (val)
-                wLen += EncodeString(os, *(string *) val);
-            break;
-        case BType::BINT:
-            val = this->Int();
-            if (val) {
-                wLen += EncodeInt(os, *(int *) val);
+    struct Frame {
+        BObject *obj;
+        size_t index;
+        DICT::iterator it;
+    };
+    //a stored container is copied from its cache,refilled first when dirty.the refill recurses,
+    //so below MaxCacheDepth stored containers are walked in place like the rest
+    auto cached = [&](BObject &node) {
+        auto cache = node.cache_.own();
+        if (!cache || !cache->store || depth >= MaxCacheDepth || (node.tag_ != Tag::List && node.tag_ != Tag::Dict)) {
+            return false;
+        }
+        if (cache->valid) {
+            CacheHits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            CacheMisses.fetch_add(1, std::memory_order_relaxed);
+            cache->bytes.clear();
+            StringOut sink{cache->bytes};
+            node.encodeWith(sink, depth + 1, false);
+            cache->valid = true;
+        }
+        out.ref(cache->bytes.data(), cache->bytes.size());
+        wLen += int(cache->bytes.size());
+        return true;
+    };
+    std::vector<Frame> stack;
+    BObject *cur = this;
+    while (true) {
+        if (cur && (useCache || cur != this) && cached(*cur)) {
+            cur = nullptr;
+        }
+        if (cur) {
+            switch (cur->type()) {
+                case BType::BSTR:
+                    wLen += putString(out, *cur->Str());
+                    break;
+                case BType::BINT:
+                    if (cur->tag_ == Tag::BigInt) {
+                        auto digits = cur->big_->digits();
+                        out.put('i');
+                        out.write(digits.data(), digits.size());
+                        out.put('e');
+                        wLen += int(digits.size() + 2);
+                    } else {
+                        wLen += putInt(out, cur->int_);
+                    }
+                    break;
+                case BType::BLIST:
+                    out.put('l');
+                    wLen++;
+                    stack.push_back({cur, 0, {}});
+                    break;
+                case BType::BDICT:
+                    out.put('d');
+                    wLen++;
+                    stack.push_back({cur, 0, cur->Dict()->begin()});
+                    break;
             }
+            cur = nullptr;
+        }
+        if (stack.empty()) {
             break;
-        case BType::BLIST:
-            val = this->List();
-            os << 'l';
-            if (val) {
-                LIST &t = *(LIST *) val;
-                for (auto &&item: t) {
-                    if (item)
-                        wLen += item->Bencode(os);
-                    else {
-                        perror(Error::ErrIvd, "pointer null! line 127");
-                    }
+        }
+        auto &top = stack.back();
+        if (top.obj->tag_ == Tag::List) {
+            auto &list = *top.obj->List();
+            if (top.index < list.size()) {
+                auto &item = list[top.index++];
+                if (item) {
+                    cur = item.get();
+                    if (top.obj->cache_.own() && !top.obj->cache_.own()->linked) link(*top.obj, *cur);
+                } else {
+                    perror(Error::ErrIvd, "pointer null! in Bencode");
                 }
+                continue;
             }
-            os << 'e';
-            wLen += 2;
+        } else if (top.it != top.obj->Dict()->end()) {
+            wLen += putString(out, top.it->first);
+            cur = top.it->second.get();
+            if (top.obj->cache_.own() && !top.obj->cache_.own()->linked) link(*top.obj, *cur);
+            ++top.it;
+            continue;
+        }
+        //every child is linked now,later walks skip it until the container changes
+        if (auto cache = top.obj->cache_.own()) cache->linked = true;
+        out.put('e');
+        wLen++;
+        stack.pop_back();
+    }
+    return wLen;
+}
+
+//strings and integers keep no bytes,they only point back at the container
+void bencode::BObject::link(BObject &parent, BObject &child) {
+    auto parentCache = parent.cache_.own();
+    if (child.tag_ != Tag::List && child.tag_ != Tag::Dict) {
+        child.cache_.link_to(parentCache);
+        return;
+    }
+    auto &cache = *child.cache_.get();
+    if (parentCache->store) {
+        cache.store = true;
+    }
+    auto &parents = cache.parents;
+    for (size_t i = 0; i < parents.size();) {
+        auto p = parents[i].lock();
+        if (p.get() == parentCache) {
+            return;
+        }
+        if (!p) {//the parent is gone
+            parents[i] = std::move(parents.back());
+            parents.pop_back();
+        } else {
+            i++;
+        }
+    }
+    parents.emplace_back(parentCache->self);
+}
+
+void bencode::BObject::invalidate(EncodeCache *cache) {
+    //a chain of single parents needs no stack,only a node held by several containers does
+    std::vector<std::shared_ptr<EncodeCache>> pending;
+    std::shared_ptr<EncodeCache> hold;
+    if (cache) {//its children may have changed,link them again on the next walk
+        cache->linked = false;
+    }
+    while (cache) {
+        cache->valid = false;
+        cache->bytes.clear();
+        std::shared_ptr<EncodeCache> next;
+        for (auto &&w: cache->parents) {
+            if (auto p = w.lock()) {
+                if (next) pending.push_back(std::move(next));
+                next = std::move(p);
+            }
+        }
+        if (!next && !pending.empty()) {
+            next = std::move(pending.back());
+            pending.pop_back();
+        }
+        hold = std::move(next);
+        cache = hold.get();
+    }
+}
+
+void bencode::BObject::mark_dirty() {
+    invalidate(cache_.target());
+}
+
+void bencode::BObject::cache_encoding(bool on) {
+    std::vector<BObject *> stack{this};
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        if (node->tag_ != Tag::List && node->tag_ != Tag::Dict) {
+            continue;
+        }
+        if (on) {
+            node->cache_.get();
+        }
+        if (auto cache = node->cache_.own()) {
+            cache->store = on;
+            cache->valid = false;
+            cache->bytes.clear();
+            cache->bytes.shrink_to_fit();
+            //a cache is still needed to dirty a cached ancestor above this tree,otherwise it goes.
+            //parents are handled first,so below a freed cache the links have already expired
+            if (!on && std::none_of(cache->parents.begin(), cache->parents.end(),
+                                    [](auto &&w) { auto p = w.lock(); return p && !p->orphan; })) {
+                node->cache_.release();
+            }
+        }
+        if (node->tag_ == Tag::List) {
+            for (auto &&item: *node->list_) {
+                if (item) stack.push_back(item.get());
+            }
+        } else {
+            for (auto &&[k, v]: *node->dict_) {
+                if (v) stack.push_back(v.get());
+            }
+        }
+    }
+}
+
+bencode::BObject::CacheStats bencode::BObject::cache_stats() {
+    return {CacheHits.load(std::memory_order_relaxed), CacheMisses.load(std::memory_order_relaxed)};
+}
+
+void bencode::BObject::reset_cache_stats() {
+    CacheHits.store(0, std::memory_order_relaxed);
+    CacheMisses.store(0, std::memory_order_relaxed);
+}
+
+int bencode::BObject::Bencode(std::ostream &os) {
+    if (!os) {
+        return 0;
+    }
+    StreamOut out{os};
+    return encodeWith(out);
+}
+
+int bencode::BObject::encode_to(std::string &out) {
+    StringOut sink{out};
+    return encodeWith(sink);
+}
+
+#ifdef BENCODE_HAS_IOVEC
+
+int bencode::BObject::encode_to(std::vector<iovec> &iov, std::string &scratch, size_t min_ref) {
+    iov.clear();
+    scratch.clear();
+    GatherOut sink{iov, scratch, min_ref};
+    auto len = encodeWith(sink);
+    sink.finish();
+    return len;
+}
+
+#endif
+
+size_t bencode::BObject::encoded_size() {
+    CountOut sink;
+    encodeWith(sink);
+    return sink.len;
+}
+
+int bencode::BObject::encode_to(char *buf, size_t cap) {
+    BufferOut sink{buf, cap};
+    return encodeWith(sink);
+}
+
+std::shared_ptr<BObject> bencode::BObject::Parse(std::istream &in, Error *error, const ParseLimits &limits) {
+    return parseStream(in, error, limits);
+}
+
+//a container being filled,its BObject is made once its 'e' is read
+struct bencode::BObject::StreamFrame {
+    bool dict;
+    LIST list;
+    DICT entries;
+    string key;
+};
+
+//iterative parsing with its own stack,so nesting is bounded by limits.max_depth only
+std::shared_ptr<BObject> bencode::BObject::parseStream(std::istream &in, Error *error, const ParseLimits &limits) {
+    std::vector<StreamFrame> stack;
+    size_t nodes = 0;
+    Error err = Error::NoError;
+    std::shared_ptr<BObject> root;
+    while (true) {
+        std::shared_ptr<BObject> val;
+        auto x = in.peek();
+        if (!stack.empty() && x == EOF) {
+            err = Error::ErrEpE;
             break;
-        case BType::BDICT:
-            val = this->Dict();
-            os << 'd';
-            if (val) {
-                DICT &t = *(DICT *) val;
-                for (auto &&[k, v]: t) {
-                    wLen += EncodeString(os, k);
-                    wLen += v->Bencode(os);
+        }
+        if (!stack.empty() && x == 'e') {//close the innermost container
+            in.get();
+            auto &top = stack.back();
+            val = top.dict ? std::make_shared<BObject>(std::move(top.entries))
+                           : std::make_shared<BObject>(std::move(top.list));
+            stack.pop_back();
+        } else {
+            if (!stack.empty() && stack.back().dict) {
+                stack.back().key = DecodeString(in, &err);
+                if (err != Error::NoError) {
+                    break;
+                }
+                x = in.peek();
+            }
+            if (++nodes > limits.max_nodes) {
+                err = Error::ErrCnt;
+                break;
+            }
+            if (std::isdigit(x)) {//parse string
+                auto str = DecodeString(in, &err);
+                if (err != Error::NoError) {
+                    break;
+                }
+                val = std::make_shared<BObject>(std::move(str));
+            } else if (x == 'i') {//parse int,kept as BigInt when it doesn't fit int64_t
+                string text;
+                char c;
+                while (in.get(c)) {
+                    text.push_back(c);
+                    if (c == 'e' || (c != 'i' && c != '-' && !std::isdigit(c))) {
+                        break;
+                    }
+                }
+                const char *cur = text.data();
+                auto num = DecodeInt(cur, text.data() + text.size(), &err);
+                if (err == Error::ErrNum) {
+                    cur = text.data();
+                    auto digits = DecodeIntDigits(cur, text.data() + text.size(), &err);
+                    if (err != Error::NoError) {
+                        break;
+                    }
+                    val = std::make_shared<BObject>(BigInt::Parse(digits));
+                } else if (err != Error::NoError) {
+                    break;
+                } else {
+                    val = std::make_shared<BObject>(num);
+                }
+            } else if (x == 'l' || x == 'd') {//open a container,its children follow
+                if (stack.size() >= limits.max_depth) {
+                    err = Error::ErrDep;
+                    break;
                 }
+                in.get();
+                stack.emplace_back();
+                stack.back().dict = x == 'd';
+                continue;
+            } else {
+                err = Error::ErrIvd;
+                break;
             }
-            os << 'e';
-            wLen += 2;
+        }
+        if (stack.empty()) {
+            root = std::move(val);
             break;
+        }
+        auto &top = stack.back();
+        if (top.dict) {
+            top.entries.emplace(InputKey(top.key), std::move(val));
+        } else {
+            top.list.emplace_back(std::move(val));
+        }
     }
+    if (error)*error = err;
+    return err == Error::NoError ? root : nullptr;
+}
 
-    return wLen;
+std::shared_ptr<BObject> bencode::BObject::Parse(std::string_view in, Error *error, size_t *consumed,
+                                                 const ParseLimits &limits) {
+    Builder builder;
+    Error err;
+    auto cur = in.data();
+    bool ok = builder.parse(cur, in.data() + in.size(), &err, limits);
+    if (error)*error = err;
+    if (consumed)*consumed = ok ? cur - in.data() : 0;
+    return ok ? std::move(builder.root) : nullptr;
 }
 
-//recursive descent parsing
-std::shared_ptr<BObject> bencode::BObject::Parse(std::istream &in, Error *error) {
-    auto x = in.peek();
-    BObject *obj;
-    if (std::isdigit(x)) {//parse string
-        auto str = DecodeString(in, error);
-        if ((error && *error != Error::NoError) || str.empty()) {
-            return nullptr;
-        }
-        obj = new BObject();
-        obj->type_ = BType::BSTR;
-        obj->value_ = str;
-    } else if (x == 'i') {//parse int
-        auto val = DecodeInt(in, error);
-        if (error && *error != Error::NoError) {
-            return nullptr;
-        }
-        obj = new BObject();
-        obj->type_ = BType::BINT;
-        obj->value_ = val;
-    } else if (x == 'l') {//parse GetList
-        in.get();
-        LIST list;
-        do {
-            if (in.peek() == 'e') {
-                in.get();
-                break;
+bool bencode::BObject::Builder::parse(const char *&cur, const char *end, Error *error, const ParseLimits &limits) {
+    size_t nodes = 0;
+    while (true) {
+        if (depth) {
+            if (cur == end) {
+                *error = Error::ErrEpE;
+                return false;
             }
-            auto ele = Parse(in, error);
-            if ((error && *error != Error::NoError) || !ele) {
-                return nullptr;
+            if (*cur == 'e') {//close the innermost container
+                cur++;
+                if (--depth == 0) {
+                    break;
+                }
+                continue;
             }
-            list.emplace_back(std::move(ele));
-        } while (true);
-        obj = new BObject();
-        obj->type_ = BType::BLIST;
-        obj->value_ = std::move(list);
-    } else if (x == 'd') {//parse GetDict
-        in.get();
-        DICT dict;
-        do {
-            if (in.peek() == 'e') {
-                in.get();
-                break;
+            if (frames[depth - 1]->tag_ == Tag::Dict) {
+                key = DecodeString(cur, end, error);
+                if (*error != Error::NoError) {
+                    return false;
+                }
+                if (cur == end) {
+                    *error = Error::ErrEpE;
+                    return false;
+                }
+            }
+        }
+        if (cur == end) {
+            *error = Error::ErrIvd;
+            return false;
+        }
+        if (++nodes > limits.max_nodes) {
+            *error = Error::ErrCnt;
+            return false;
+        }
+        auto x = *cur;
+        if (x >= '0' && x <= '9') {
+            auto str = DecodeString(cur, end, error);
+            if (*error != Error::NoError) {
+                return false;
             }
-            auto key = DecodeString(in, error);
-            if ((error && *error != Error::NoError) || key.empty()) {
-                return nullptr;
+            on_string(str);
+        } else if (x == 'i') {//kept as BigInt when it doesn't fit int64_t
+            auto val = DecodeInt(cur, end, error);
+            if (*error == Error::ErrNum) {
+                auto digits = DecodeIntDigits(cur, end, error);
+                if (*error != Error::NoError) {
+                    return false;
+                }
+                on_bigint(digits);
+            } else if (*error != Error::NoError) {
+                return false;
+            } else {
+                on_int(val);
             }
-            auto val = Parse(in, error);
-            if ((error && *error != Error::NoError) || !val) {
-                return nullptr;
+        } else if (x == 'l' || x == 'd') {
+            if (depth >= limits.max_depth) {
+                *error = Error::ErrDep;
+                return false;
             }
-            dict.emplace(std::move(key), std::move(val));
-        } while (true);
-        obj = new BObject();
-        obj->type_ = BType::BDICT;
-        obj->value_ = std::move(dict);
-    } else {
-        if (error)*error = Error::ErrIvd;
-        return nullptr;
+            cur++;
+            if (x == 'l') on_list_begin();
+            else on_dict_begin();
+            continue;
+        } else {
+            *error = Error::ErrIvd;
+            return false;
+        }
+        if (depth == 0) {
+            break;
+        }
     }
-    if (error)*error = Error::NoError;
-    return std::shared_ptr<BObject>(obj);
+    *error = Error::NoError;
+    return true;
 }
 
-//converse string to stringstream and to Parse
+//parse straight from the string buffer,no stringstream copy
 bencode::Bencode bencode::BObject::parse(std::string text) {
-    std::istringstream reader(std::move(text));
     Error error;
-    auto ptr = Parse(reader,&error);
+    auto ptr = Parse(std::string_view(text), &error);
     if(error!=Error::NoError){
         throw std::runtime_error("parse error");
     }
@@ -199,59 +663,50 @@ bencode::Bencode bencode::BObject::parse(std::string text) {
 
 
 
-int bencode::BObject::getIntLen(int val) {
-    int ret = 0;
-    if (val < 0) {
-        ret = 1;
-        val *= -1;
-    }
-    do {
-        ret++;
-        val /= 10;
-    } while (val);
-    return ret;
+int bencode::BObject::getIntLen(int64_t val) {
+    return IntLength(val);
 }
 
 int bencode::BObject::EncodeString(std::ostream &os, std::string_view val) {
-    int len = val.size();
-    if (len <= 0)
-        return 0;
-    os << len;
-    int wLen = getIntLen(len);
-    os << ":";
-    wLen++;
-    os << val;
-    wLen += len;
-
-    return wLen;
+    StreamOut out{os};
+    return putString(out, val);
 }
 
 
+//same form as the buffer decoder:digits,':',then that many bytes."0:" is the empty string
 std::string bencode::BObject::DecodeString(std::istream &in, Error *error) {
-    int len;
-    in >> len;
-    if (len == 0) {
+    size_t len = 0;
+    size_t digits = 0;
+    while (std::isdigit(in.peek())) {
+        if (len > (SIZE_MAX - 9) / 10) {
+            if (error)*error = Error::ErrIvd;
+            return "";
+        }
+        len = len * 10 + (in.get() - '0');
+        digits++;
+    }
+    if (digits == 0) {
         if (error)*error = Error::ErrNum;
         return "";
     }
-
-    char b;
-    in.get(b);
-    if (b != ':') {
+    if (in.get() != ':') {
         if (error)*error = Error::ErrCol;
         return "";
     }
 
+    //read in pieces,a bogus length on a short stream must not allocate all of it up front
     string ret_v;
-    ret_v.reserve(len);  //TODO 提前分配内存防止中途分配内存
-    int rdlen = 0;
-    char x;
-    while (rdlen < len && in.get(x)) {
-        ret_v.push_back(x);
-        rdlen++;
+    char buf[4096];
+    while (ret_v.size() < len) {
+        auto want = std::min(sizeof(buf), len - ret_v.size());
+        in.read(buf, std::streamsize(want));
+        ret_v.append(buf, size_t(in.gcount()));
+        if (size_t(in.gcount()) != want) {
+            break;
+        }
     }
 
-    if (rdlen != len) {
+    if (ret_v.size() != len) {
         if (error)*error = Error::ErrIvd;
         return "";
     }
@@ -259,74 +714,305 @@ std::string bencode::BObject::DecodeString(std::istream &in, Error *error) {
     return ret_v;
 }
 
-int bencode::BObject::EncodeInt(std::ostream &os, int val) {
-    int wLen = 0;
-    os << 'i';
-    wLen++;
-    os << val;
-    wLen += getIntLen(val);
-    os << 'e';
-    wLen++;
+std::string_view bencode::BObject::DecodeString(const char *&cur, const char *end, Error *error) {
+    size_t len = 0;
+    auto p = cur;
+    while (p != end && *p >= '0' && *p <= '9') {
+        len = len * 10 + (*p - '0');
+        if (len > size_t(end - cur)) {//longer than the whole buffer,can't be valid
+            if (error)*error = Error::ErrIvd;
+            return {};
+        }
+        p++;
+    }
+    if (p == cur) {
+        if (error)*error = Error::ErrNum;
+        return {};
+    }
+    if (p == end || *p != ':') {
+        if (error)*error = Error::ErrCol;
+        return {};
+    }
+    p++;
+    if (size_t(end - p) < len) {
+        if (error)*error = Error::ErrIvd;
+        return {};
+    }
+    cur = p + len;
+    if (error)*error = Error::NoError;
+    return {p, len};
+}
 
-    return wLen;
+int bencode::BObject::EncodeInt(std::ostream &os, int64_t val) {
+    StreamOut out{os};
+    return putInt(out, val);
+}
+
+int bencode::BObject::EncodeIntDigits(std::ostream &os, std::string_view digits) {
+    os.put('i');
+    os.write(digits.data(), std::streamsize(digits.size()));
+    os.put('e');
+    return int(digits.size() + 2);
 }
 
-int bencode::BObject::DecodeInt(std::istream &in, Error *error) {
+int64_t bencode::BObject::DecodeInt(std::istream &in, Error *error) {
+    //collect "i...e" and hand it to the buffer decoder,so both paths accept the same forms.
+    //21 characters hold "i",a sign,19 digits,anything longer can't be a valid int64_t
+    char buf[23];
+    size_t n = 0;
     char x;
-    in.get(x);
-    if (x != 'i') {
+    while (n < sizeof(buf) && in.get(x)) {
+        buf[n++] = x;
+        if (x == 'e' || (n == 1 && x != 'i')) {
+            break;
+        }
+    }
+    const char *cur = buf;
+    return DecodeInt(cur, buf + n, error);
+}
+
+int64_t bencode::BObject::DecodeInt(const char *&cur, const char *end, Error *error) {
+    auto p = cur;
+    if (p == end || *p != 'i') {
         if (error)*error = Error::ErrEpI;
         return 0;
     }
+    p++;
+    bool neg = false;
+    if (p != end && *p == '-') {
+        neg = true;
+        p++;
+    }
+    auto digits = p;
+    //up to 19 digits can't overflow uint64_t,longer runs are rejected below and may wrap harmlessly
+    uint64_t val = 0;
+    bool more = true;
+    if constexpr(SwarDigits) {
+        while (more && end - p >= 8) {
+            auto chunk = LoadEight(p);
+            auto n = DigitRun(chunk);
+            if (n == 8) {
+                val = val * 100000000 + ParseDigits(chunk, 8);
+            } else {
+                if (n) {
+                    static constexpr uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+                    val = val * pow10[n] + ParseDigits(chunk, n);
+                }
+                more = false;
+            }
+            p += n;
+        }
+    }
+    if (more) {
+        while (p != end && *p >= '0' && *p <= '9') {
+            val = val * 10 + (*p - '0');
+            p++;
+        }
+    }
+    auto n = p - digits;
+    if (n == 0 || n > 19) {
+        if (error)*error = Error::ErrNum;
+        return 0;
+    }
+    if (*digits == '0' && (n > 1 || neg)) {//leading zero or "-0"
+        if (error)*error = Error::ErrNum;
+        return 0;
+    }
+    if (val > uint64_t(INT64_MAX) + neg) {
+        if (error)*error = Error::ErrNum;
+        return 0;
+    }
+    if (p == end || *p != 'e') {
+        if (error)*error = Error::ErrEpE;
+        return 0;
+    }
+    cur = p + 1;
+    if (error)*error = Error::NoError;
+    return neg ? int64_t(0 - val) : int64_t(val);
+}
 
-    int val;
-    in >> val;
-    in.get(x);
-
-    if (x != 'e') {
+std::string_view bencode::BObject::DecodeIntDigits(const char *&cur, const char *end, Error *error) {
+    auto p = cur;
+    if (p == end || *p != 'i') {
         if (error)*error = Error::ErrEpI;
-        return val;
+        return {};
+    }
+    auto start = ++p;
+    bool neg = p != end && *p == '-';
+    p += neg;
+    auto digits = p;
+    while (p != end && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (p == digits || (*digits == '0' && (p - digits > 1 || neg))) {
+        if (error)*error = Error::ErrNum;
+        return {};
+    }
+    if (p == end || *p != 'e') {
+        if (error)*error = Error::ErrEpE;
+        return {};
     }
+    cur = p + 1;
     if (error)*error = Error::NoError;
-    return val;
+    return {start, size_t(p - start)};
 }
 
-BObject &bencode::BObject::operator=(int v) {
-    value_ = v;
-    type_ = BType::BINT;
+BObject &bencode::BObject::operator=(int64_t v) {
+    mark_dirty();
+    reset();
+    int_ = v;
     return *this;
 }
 
 BObject &bencode::BObject::operator=(string str) {
-    value_ = std::move(str);
-    type_ = BType::BSTR;
+    mark_dirty();
+    if (tag_ == Tag::Str) {
+        *str_ = std::move(str);
+        return *this;
+    }
+    reset();
+    str_ = new string(std::move(str));
+    tag_ = Tag::Str;
     return *this;
 }
 
 BObject &bencode::BObject::operator=(BObject::LIST list) {
-    type_ = BType::BLIST;
-    value_ = std::move(list);
+    mark_dirty();
+    if (tag_ == Tag::List) {
+        *list_ = std::move(list);
+        return *this;
+    }
+    reset();
+    list_ = new LIST(std::move(list));
+    tag_ = Tag::List;
     return *this;
 }
 
 BObject &bencode::BObject::operator=(DICT dict) {
-    type_ = BType::BDICT;
-    value_ = std::move(dict);
+    mark_dirty();
+    if (tag_ == Tag::Dict) {
+        *dict_ = std::move(dict);
+        return *this;
+    }
+    reset();
+    dict_ = new DICT(std::move(dict));
+    tag_ = Tag::Dict;
     return *this;
 }
 
-bencode::BObject::BObject(std::string v) : value_(std::move(v)), type_(BType::BSTR) {
+bencode::BObject::BObject(const BObject &other) : int_(0), cache_(other.cache_), tag_(Tag::Int) {
+    copyValue(other);
+}
 
+bencode::BObject::BObject(BObject &&other) noexcept : int_(other.int_), cache_(std::move(other.cache_)),
+                                                      tag_(other.tag_) {
+    other.tag_ = Tag::Int;
+    other.int_ = 0;
 }
 
-bencode::BObject::BObject(int v) : value_(v), type_(BType::BINT) {
+bencode::BObject::~BObject() {
+    reset();
 }
 
-bencode::BObject::BObject(BObject::LIST list) : value_(std::move(list)), type_(BType::BLIST) {
+//copied first,other may live inside the value being replaced
+BObject &bencode::BObject::operator=(const BObject &other) {
+    if (this != &other) {
+        *this = BObject(other);
+    }
+    return *this;
+}
 
+BObject &bencode::BObject::operator=(BObject &&other) noexcept {
+    if (this != &other) {
+        cache_ = std::move(other.cache_);
+        auto value = other.int_;
+        auto tag = other.tag_;
+        other.tag_ = Tag::Int;
+        other.int_ = 0;
+        reset();
+        int_ = value;
+        tag_ = tag;
+    }
+    return *this;
 }
 
-bencode::BObject::BObject(BObject::DICT dict) : value_(std::move(dict)), type_(BType::BDICT) {
+void bencode::BObject::reset() {
+    //containers only this node holds are taken out first and freed one at a time,
+    //so dropping a deeply nested tree doesn't recurse once per level
+    std::vector<std::shared_ptr<BObject>> pending;
+    auto detach = [&pending](BObject &node) {
+        auto take = [&pending](std::shared_ptr<BObject> &child) {
+            if (child && child.use_count() == 1 && (child->tag_ == Tag::List || child->tag_ == Tag::Dict)) {
+                pending.push_back(std::move(child));
+            }
+        };
+        if (node.tag_ == Tag::List) {
+            for (auto &&child: *node.list_) take(child);
+        } else if (node.tag_ == Tag::Dict) {
+            for (auto &&[k, v]: *node.dict_) take(v);
+        }
+    };
+    detach(*this);
+    while (!pending.empty()) {
+        auto node = std::move(pending.back());
+        pending.pop_back();
+        detach(*node);
+    }
+    switch (tag_) {
+        case Tag::Str:
+            delete str_;
+            break;
+        case Tag::List:
+            delete list_;
+            break;
+        case Tag::Dict:
+            delete dict_;
+            break;
+        case Tag::BigInt:
+            delete big_;
+            break;
+        case Tag::Int:
+            break;
+    }
+    tag_ = Tag::Int;
+    int_ = 0;
+}
+
+//this holds the integer 0 when called
+void bencode::BObject::copyValue(const BObject &other) {
+    switch (other.tag_) {
+        case Tag::Str:
+            str_ = new string(*other.str_);
+            break;
+        case Tag::List:
+            list_ = new LIST(*other.list_);
+            break;
+        case Tag::Dict:
+            dict_ = new DICT(*other.dict_);
+            break;
+        case Tag::BigInt:
+            big_ = new BigInt(*other.big_);
+            break;
+        case Tag::Int:
+            int_ = other.int_;
+            break;
+    }
+    tag_ = other.tag_;
+}
+
+bencode::BObject::BObject(std::string v) : str_(new string(std::move(v))), tag_(Tag::Str) {
+
+}
+
+bencode::BObject::BObject(BigInt v) : big_(new BigInt(std::move(v))), tag_(Tag::BigInt) {
+
+}
+
+bencode::BObject::BObject(BObject::LIST list) : list_(new LIST(std::move(list))), tag_(Tag::List) {
+
+}
+
+bencode::BObject::BObject(BObject::DICT dict) : dict_(new DICT(std::move(dict))), tag_(Tag::Dict) {
 
 }
 
@@ -336,77 +1022,97 @@ bencode::BObject::BObject(const char *str) : BObject(string(str)) {
 
 #define PRINT_NEXT_LINE(var)  obj.append(string(var,' '));
 
+//iterative,a container's place in its walk is kept on stack instead of the call stack
 void bencode::BObject::get_json(int curRowLen, std::string &obj) {
-    switch (type_) {
-        case BType::BSTR:{
-            auto str = Str();
-            if(!str){
-                NULL_ERROR(to_string,STR)
-            }
-            auto src_str = R"(")"+*str+R"(")";
-            obj.append(src_str);
-            break;
-        }
-        case BType::BINT:{
-            auto integer = Int();
-            if(!integer){
-                NULL_ERROR(to_string,INT)
+    struct Frame {
+        BObject *node;
+        int rowLen;
+        size_t index;
+        DICT::iterator it;
+    };
+    std::vector<Frame> stack;
+    //writes a scalar,or opens a container and pushes its frame
+    auto open = [&](BObject *node, int rowLen) {
+        switch (node->type()) {
+            case BType::BSTR:{
+                auto str = node->Str();
+                if(!str){
+                    NULL_ERROR(to_string,STR)
+                }
+                obj.append(R"(")").append(*str).append(R"(")");
+                break;
             }
-            auto src_str = std::to_string(*integer);
-            obj.append(src_str);
-            break;
-        }
-        case BType::BLIST:{
-            auto list = List();
-            if(!list){
-                NULL_ERROR(to_string,LIST)
+            case BType::BINT:{
+                obj.append(node->raw_digits());
+                break;
             }
-            obj.append("[");
-            curRowLen += 1;
-            for(int i=0;i<list->size();i++){
-                auto& item = list->at(i);
-                if(item->type_==BType::BDICT){
-                    obj.push_back('\n');
-                    PRINT_NEXT_LINE(curRowLen)
-                    item->get_json(curRowLen, obj);
-                }else{
-                    item->get_json(curRowLen, obj);
+            case BType::BLIST:{
+                if(!node->List()){
+                    NULL_ERROR(to_string,LIST)
                 }
-                if(i!=list->size()-1){
-                    obj.append(", ");
-                    curRowLen += 2;
+                obj.append("[");
+                stack.push_back({node, rowLen + 1, 0, {}});
+                break;
+            }
+            case BType::BDICT:{
+                auto dict = node->Dict();
+                if(!dict){
+                    NULL_ERROR(to_string,DICT)
                 }
+                obj.append("{\n");
+                PRINT_NEXT_LINE(rowLen)
+                stack.push_back({node, rowLen, 0, dict->begin()});
+                break;
             }
-            obj.append("]");
-            curRowLen+=1;
-            break;
         }
-        case BType::BDICT:{
-            auto dict = Dict();
-            if(!dict){
-                NULL_ERROR(to_string,DICT)
+    };
+    open(this, curRowLen);
+    while (!stack.empty()) {
+        auto &top = stack.back();
+        if (top.node->tag_ == Tag::List) {
+            auto list = top.node->List();
+            if (top.index == list->size()) {
+                obj.append("]");
+                stack.pop_back();
+                continue;
             }
-            obj.append("{\n");
-            PRINT_NEXT_LINE(curRowLen)
-            for(auto&&[k,v]:*dict){
-                auto format_keyStr = R"(")"+k+R"(":)";
-                obj.append(format_keyStr);
-                auto newLen = curRowLen+format_keyStr.size();
-                if(v->type_==BType::BDICT){
-                    obj.push_back('\n');
-                    PRINT_NEXT_LINE(newLen)
-                    v->get_json(newLen, obj);
-                }else{
-                    v->get_json(curRowLen, obj);
-                }
+            if (top.index != 0) {
+                obj.append(", ");
+                top.rowLen += 2;
+            }
+            auto item = (*list)[top.index++].get();
+            auto rowLen = top.rowLen;
+            if(item->tag_==Tag::Dict){
+                obj.push_back('\n');
+                PRINT_NEXT_LINE(rowLen)
+            }
+            open(item, rowLen);
+        } else {
+            //every entry is followed by ",\n",written once the walk is back
+            if (top.index != 0) {
                 obj.append(",\n");
-                PRINT_NEXT_LINE(curRowLen)
+                PRINT_NEXT_LINE(top.rowLen)
+            }
+            if (top.it == top.node->Dict()->end()) {
+                obj.append("}");
+                stack.pop_back();
+                continue;
+            }
+            auto &[k, v] = *top.it++;
+            top.index++;
+            auto rowLen = top.rowLen;
+            auto format_keyStr = std::string(R"(")").append(std::string_view(k)).append(R"(":)");
+            obj.append(format_keyStr);
+            if(v->tag_==Tag::Dict){
+                auto newLen = rowLen + int(format_keyStr.size());
+                obj.push_back('\n');
+                PRINT_NEXT_LINE(newLen)
+                open(v.get(), newLen);
+            }else{
+                open(v.get(), rowLen);
             }
-            obj.append("}");
-            break;
         }
     }
-
 }
 
 std::string bencode::BObject::to_string() {
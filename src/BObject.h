@@ -6,10 +6,19 @@
 #define TEST_BENCODE_BOBJECT_H
 #include "config.h"
 #include "type.h"
+#include "BigInt.h"
 #include <memory>
-#include <variant>
 #include <stdexcept>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+#include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#define BENCODE_HAS_IOVEC
+#endif
 
 namespace bencode{
     //pre statement
@@ -21,8 +30,7 @@ namespace bencode{
     class BObject {
     public:
         using LIST = std::vector<std::shared_ptr<BObject>>;
-        using DICT = __DICT__<std::string, std::shared_ptr<BObject>>;
-        using BValue = std::variant<int, std::string, LIST, DICT>;
+        using DICT = NodeDict<__KEY__, std::shared_ptr<BObject>>;
 
         friend class BEntity<LIST>;
 
@@ -32,14 +40,28 @@ namespace bencode{
 
         friend class BEntity<DICT>;
 
-        BObject() = default;
+        BObject() : int_(0), tag_(Tag::Int) {}
+
+        BObject(const BObject &other);
+
+        BObject(BObject &&other) noexcept;
+
+        ~BObject();
+
+        BObject &operator=(const BObject &other);
+
+        BObject &operator=(BObject &&other) noexcept;
 
         // 构造函数转化五件套
         explicit BObject(std::string);
 
         explicit BObject(const char *str);
 
-        explicit BObject(int v);
+        //any integer type,stored as int64_t
+        template<class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        explicit BObject(T v) : int_(int64_t(v)), tag_(Tag::Int) {}
+
+        explicit BObject(BigInt v);
 
         explicit BObject(LIST list);
 
@@ -48,9 +70,9 @@ namespace bencode{
         //强转重载
         operator std::string();
 
-        operator int();
+        operator int64_t();
 
-        BObject &operator=(int);
+        BObject &operator=(int64_t);
 
         BObject &operator=(std::string);
 
@@ -60,7 +82,17 @@ namespace bencode{
 
         std::string *Str(Error *error_code = nullptr);
 
-        int *Int(Error *error_code = nullptr);
+        //ErrNum if the integer doesn't fit int64_t,see as_bigint()
+        int64_t *Int(Error *error_code = nullptr);
+
+        //checked integer conversion,ErrTyp for a non integer,ErrNum when the value doesn't fit T
+        template<class T>
+        T as(Error *error_code = nullptr);
+
+        BigInt as_bigint(Error *error_code = nullptr);
+
+        //decimal text of the integer,as it appeared in the input
+        std::string raw_digits(Error *error_code = nullptr);
 
         LIST *List(Error *error_code = nullptr);
 
@@ -69,7 +101,61 @@ namespace bencode{
 
         int Bencode(std::ostream &os);
 
-        static std::shared_ptr<BObject> Parse(std::istream &in, Error *error);
+        //append the encoding to out without going through iostreams,returns the bytes written
+        int encode_to(std::string &out);
+
+        //write into buf,at most cap bytes.returns the full encoded length,the output is
+        //complete only when that is <= cap
+        int encode_to(char *buf, size_t cap);
+
+        //exact number of bytes Bencode/encode_to will produce,nothing is written.
+        //walks the tree like encoding does,so reserve with it only when one buffer is required
+        size_t encoded_size();
+
+#ifdef BENCODE_HAS_IOVEC
+        //string payloads at least this long are referenced,not copied
+        static constexpr size_t GatherMinRef = 64;
+
+        //scatter-gather encoding for writev/sendmsg:iov and scratch are cleared,then iov is filled
+        //in order.delimiters,length prefixes,integers and short strings are copied into scratch,
+        //strings of min_ref bytes or more point at their storage in this tree.the entries stay
+        //valid while scratch and the tree are alive and unmodified.returns the total byte count
+        int encode_to(std::vector<iovec> &iov, std::string &scratch, size_t min_ref = GatherMinRef);
+#endif
+
+        struct CacheStats {
+            uint64_t hits;
+            uint64_t misses;
+        };
+
+        //keep the encoded bytes of this container and of the containers below it,so encoding again
+        //copies unchanged subtrees instead of walking them.assignment,BEntity put/add and the Bencode
+        //setters mark the changed node and its ancestors dirty;after changing a node through
+        //Str()/Int()/List()/Dict(),call mark_dirty() on it.strings and integers keep no bytes,only a
+        //link to the container holding them.cache_encoding(false) frees the stored bytes.encoding a
+        //tree with the cache on modifies the cache,so it must not run on two threads at once
+        void cache_encoding(bool on = true);
+
+        void mark_dirty();
+
+        //process wide counts of cached subtrees reused and re-encoded
+        static CacheStats cache_stats();
+
+        static void reset_cache_stats();
+
+        //reads one value from a stream,nesting and size bounded by limits as for a buffer
+        static std::shared_ptr<BObject> Parse(std::istream &in, Error *error, const ParseLimits &limits = {});
+
+        //parse directly from a contiguous buffer,consumed receives the number of bytes used.
+        //one iterative loop feeding the same Builder PushParser uses,so nesting costs no call stack
+        static std::shared_ptr<BObject> Parse(std::string_view in, Error *error, size_t *consumed = nullptr,
+                                              const ParseLimits &limits = {});
+
+        template<size_t N>
+        static std::shared_ptr<BObject> Parse(std::span<const char, N> in, Error *error, size_t *consumed = nullptr,
+                                              const ParseLimits &limits = {}) {
+            return Parse(std::string_view(in.data(), in.size()), error, consumed, limits);
+        }
 
         static  class Bencode parse(std::string text);
 
@@ -77,18 +163,30 @@ namespace bencode{
 
         static std::string DecodeString(std::istream &in, Error *error);
 
-        static int EncodeInt(std::ostream &os, int val);
+        static std::string_view DecodeString(const char *&cur, const char *end, Error *error);
+
+        static int EncodeInt(std::ostream &os, int64_t val);
+
+        //"i" digits "e" for an integer kept as text
+        static int EncodeIntDigits(std::ostream &os, std::string_view digits);
+
+        static int64_t DecodeInt(std::istream &in, Error *error);
 
-        static int DecodeInt(std::istream &in, Error *error);
+        //canonical form only:no leading zeros,no "-0",the value must fit in int64_t
+        static int64_t DecodeInt(const char *&cur, const char *end, Error *error);
+
+        //same canonical checks without the range limit,returns the text between 'i' and 'e'
+        static std::string_view DecodeIntDigits(const char *&cur, const char *end, Error *error);
 
         template<class T>
         T value() {
             T *ptr;
             if constexpr(isInteger<T>::value) {
-                ptr = Int();
-                if (!ptr) {
+                auto val = Int();
+                if (!val) {
                     throw std::runtime_error("BObject value() error,change to int failed!");
                 }
+                return T(*val);
             } else if constexpr(isString<T>::value) {
                 ptr = Str();
                 if (!ptr) {
@@ -99,7 +197,7 @@ namespace bencode{
                 if (!ptr) {
                     throw std::runtime_error("BObject value() error,change to List failed!");
                 }
-            } else if constexpr(isMap<T>::value) {
+            } else if constexpr(isMap<T>::value || std::is_same_v<T, DICT>) {
                 ptr = Dict();
                 if (!ptr) {
                     throw std::runtime_error("BObject value() error,change to Dict failed!");
@@ -110,14 +208,270 @@ namespace bencode{
             }
             return *ptr;
         }
+        //Reader handler producing a BObject tree,used by Parse(std::string_view) and PushParser
+        struct Builder;
+
         void get_json(int curRowLen, std::string & obj);
         std::string to_string();
     private:
-        static int getIntLen(int val);
+        static int getIntLen(int64_t val);
+
+
+        struct StreamFrame;
+
+        static std::shared_ptr<BObject> parseStream(std::istream &in, Error *error, const ParseLimits &limits);
+
+        //the walk root is encoded even when it has cached bytes,encoding its cache relies on that
+        template<class Out>
+        int encodeWith(Out &out, size_t depth = 0, bool useCache = true);
+
+        //which member of the payload is live,integers outside int64_t are kept as BigInt and are
+        //BINT too.only integers are stored inline,Str()/List()/Dict() hand out pointers so the
+        //rest lives out of line and the node stays at 24 bytes
+        enum class Tag : uint8_t {
+            Str,
+            Int,
+            List,
+            Dict,
+            BigInt
+        };
+
+        BType type() const {
+            return tag_ == Tag::BigInt ? BType::BINT : BType(tag_);
+        }
+
+        //frees the out of line value,the node is left holding the integer 0.iterative,see BObject.cpp
+        void reset();
+
+        void copyValue(const BObject &other);
+
+        //cached encoding and links to the caches of the containers holding this node,
+        //weak so a parent going away never leaves a dangling link
+        struct EncodeCache {
+            std::string bytes;
+            bool store = false;//a container keeping its bytes
+            bool valid = false;
+            bool linked = false;//the children hold a link to this cache
+            size_t leaves = 0;//strings and integers linked to this cache,see CacheSlot
+            bool orphan = false;//its node let go of it,the linked leaves keep it until they unlink
+            std::vector<std::weak_ptr<EncodeCache>> parents;
+            std::shared_ptr<EncodeCache> self;//the node's reference,dropped with the node and its leaves
+        };
+
+        //one pointer in the node:the node's own cache,which owns itself through self so children can
+        //keep weak links,or for a string or integer a counted link to the cache of the container
+        //holding it,marked by the low bit.a leaf shared by two cached containers gets a cache of its
+        //own with both as parents.a copied or moved node starts without either,assigning to a node
+        //marks it dirty
+        struct CacheSlot {
+            uintptr_t bits = 0;
+
+            CacheSlot() = default;
+
+            CacheSlot(const CacheSlot &) {}
+
+            CacheSlot(CacheSlot &&) noexcept {}
+
+            ~CacheSlot() {
+                release();
+            }
+
+            CacheSlot &operator=(const CacheSlot &) {
+                invalidate(target());
+                return *this;
+            }
+
+            CacheSlot &operator=(CacheSlot &&) noexcept {
+                invalidate(target());
+                return *this;
+            }
+
+            //the node's own cache,nullptr for none or a link
+            EncodeCache *own() const {
+                return bits & 1 ? nullptr : reinterpret_cast<EncodeCache *>(bits);
+            }
+
+            //the container cache a leaf is linked to
+            EncodeCache *link() const {
+                return bits & 1 ? reinterpret_cast<EncodeCache *>(bits & ~uintptr_t(1)) : nullptr;
+            }
+
+            //where a change to the node has to be recorded
+            EncodeCache *target() const {
+                return reinterpret_cast<EncodeCache *>(bits & ~uintptr_t(1));
+            }
+
+            EncodeCache *get() {
+                if (auto cache = own()) {
+                    return cache;
+                }
+                auto parent = link();
+                auto cache = std::make_shared<EncodeCache>();
+                cache->self = cache;
+                bits = reinterpret_cast<uintptr_t>(cache.get());
+                if (parent) {
+                    if (!parent->orphan) cache->parents.emplace_back(parent->self);
+                    unlink(parent);
+                }
+                return cache.get();
+            }
+
+            //link a leaf to the cache of the container holding it
+            void link_to(EncodeCache *parent) {
+                auto cur = link();
+                if (cur == parent) {
+                    return;
+                }
+                if (cur && cur->orphan) {
+                    unlink(cur);
+                    bits = 0;
+                    cur = nullptr;
+                }
+                if (cur || own()) {//held by a second container,or was one itself
+                    auto cache = get();
+                    for (auto &&w: cache->parents) {
+                        if (w.lock().get() == parent) return;
+                    }
+                    cache->parents.emplace_back(parent->self);
+                    return;
+                }
+                parent->leaves++;
+                bits = reinterpret_cast<uintptr_t>(parent) | 1;
+            }
+
+            //weak links from the children expire with the node,or with its last linked leaf
+            void release() {
+                if (auto cache = own()) {
+                    if (cache->leaves) cache->orphan = true;
+                    else auto owner = std::move(cache->self);
+                } else if (auto parent = link()) {
+                    unlink(parent);
+                }
+                bits = 0;
+            }
+
+        private:
+            static void unlink(EncodeCache *parent) {
+                if (--parent->leaves == 0 && parent->orphan) {
+                    auto owner = std::move(parent->self);
+                }
+            }
+        };
+
+        static void invalidate(EncodeCache *cache);
+
+        static void link(BObject &parent, BObject &child);
     private:
-        int space_num_{};
-        BType type_;
-        BValue value_;
+        union {
+            int64_t int_;
+            std::string *str_;
+            LIST *list_;
+            DICT *dict_;
+            BigInt *big_;
+        };
+        CacheSlot cache_;
+        Tag tag_;
+    };
+
+    template<class T>
+    T BObject::as(Error *error_code) {
+        static_assert(std::is_integral_v<T>, "as<T>() converts to integer types only");
+        if (tag_ == Tag::BigInt) {
+            return big_->as<T>(error_code);
+        }
+        if (tag_ != Tag::Int) {
+            if (error_code)*error_code = Error::ErrTyp;
+            return 0;
+        }
+        auto val = int_;
+        if (!std::in_range<T>(val)) {
+            if (error_code)*error_code = Error::ErrNum;
+            return 0;
+        }
+        if (error_code)*error_code = Error::NoError;
+        return T(val);
+    }
+
+    //Reader handler that builds a BObject tree,containers are attached to their parent as soon
+    //as they open so the frame stack only remembers which container the next value goes into.
+    //the key passed to on_key() must stay valid until its value has been delivered
+    struct BObject::Builder {
+        std::shared_ptr<BObject> root;
+        //most messages are a few levels deep,so frames start out in a fixed array
+        BObject *small[32];
+        std::vector<BObject *> big;
+        BObject **frames = small;
+        size_t depth = 0;
+        size_t cap = 32;
+        std::string_view key;
+        std::vector<std::shared_ptr<BObject>> dropped;//values of repeated dict keys,parsed then ignored
+
+        //the tree path of Parse(std::string_view):the Reader's state machine inlined into one loop,
+        //the same checks and errors without a call per token.cur is left past the value
+        bool parse(const char *&cur, const char *end, Error *error, const ParseLimits &limits);
+
+        void attach(std::shared_ptr<BObject> &&obj) {
+            if (depth == 0) {
+                root = std::move(obj);
+                return;
+            }
+            auto parent = frames[depth - 1];
+            if (parent->tag_ == Tag::List) {
+                parent->list_->push_back(std::move(obj));
+                return;
+            }
+            //like the stream parser the first occurrence of a key wins
+            auto inserted = parent->dict_->try_emplace(InputKey(key), std::move(obj)).second;
+            if (!inserted) {
+                dropped.push_back(std::move(obj));
+            }
+        }
+
+        void on_int(int64_t val) {
+            attach(std::make_shared<BObject>(val));
+        }
+
+        void on_bigint(std::string_view digits) {
+            attach(std::make_shared<BObject>(BigInt::Parse(digits)));
+        }
+
+        void on_string(std::string_view str) {
+            attach(std::make_shared<BObject>(std::string(str)));
+        }
+
+        void on_key(std::string_view k) {
+            key = k;
+        }
+
+        void push(std::shared_ptr<BObject> &&obj) {
+            auto raw = obj.get();
+            attach(std::move(obj));
+            if (depth == cap) {
+                if (frames == small) {
+                    big.assign(small, small + depth);
+                }
+                cap *= 2;
+                big.resize(cap);
+                frames = big.data();
+            }
+            frames[depth++] = raw;
+        }
+
+        void on_list_begin() {
+            push(std::make_shared<BObject>(LIST()));
+        }
+
+        void on_dict_begin() {
+            push(std::make_shared<BObject>(DICT()));
+        }
+
+        void on_list_end() {
+            depth--;
+        }
+
+        void on_dict_end() {
+            depth--;
+        }
     };
 }
 #endif //TEST_BENCODE_BOBJECT_H
@@ -0,0 +1,104 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Batch.h"
+#include <algorithm>
+#include <utility>
+
+using bencode::BatchParser;
+using bencode::BatchResult;
+
+void bencode::ParseContext::parse(std::span<const std::string_view> msgs, BatchResult *out,
+                                  const ParseLimits &limits) {
+    arena_.reset();
+    for (auto &&msg: msgs) {
+        auto &res = *out++;
+        if (!Document::parseInto(res.root, msg, arena_, items_, entries_, &res.error, &res.consumed, limits)) {
+            res.root = BView();
+        }
+    }
+}
+
+BatchParser::BatchParser(size_t threads, const ParseLimits &limits)
+        : limits_(limits), contexts_(std::max<size_t>(threads, 1)) {
+    //the calling thread takes the first slice itself
+    for (size_t i = 1; i < contexts_.size(); i++) {
+        workers_.emplace_back(&BatchParser::work, this, i);
+    }
+}
+
+BatchParser::~BatchParser() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (auto &&t: workers_) {
+        t.join();
+    }
+}
+
+void BatchParser::run(size_t id) {
+    auto begin = std::min(id * slice_, msgs_.size());
+    auto end = std::min(begin + slice_, msgs_.size());
+    try {
+        contexts_[id].parse(msgs_.subspan(begin, end - begin), results_.data() + begin, limits_);
+    } catch (...) {//the first one is rethrown by parse_batch() on the calling thread
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!failure_) failure_ = std::current_exception();
+    }
+}
+
+void BatchParser::work(size_t id) {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stop_ || (round_ != seen && id <= active_); });
+            if (stop_) {
+                return;
+            }
+            seen = round_;
+        }
+        run(id);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+std::span<BatchResult> BatchParser::parse_batch(std::span<const std::string_view> msgs) {
+    results_.resize(msgs.size());
+    auto threads = std::min(contexts_.size(), std::max<size_t>(msgs.size() / MinPerThread, 1));
+    if (threads == 1) {
+        contexts_[0].parse(msgs, results_.data(), limits_);
+        return results_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        msgs_ = msgs;
+        slice_ = (msgs.size() + threads - 1) / threads;
+        //rounding up the slice may leave the last workers without messages,they sit the round out
+        active_ = (msgs.size() + slice_ - 1) / slice_ - 1;
+        pending_ = active_;
+        round_++;
+    }
+    start_.notify_all();
+    run(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+    if (failure_) {
+        std::rethrow_exception(std::exchange(failure_, nullptr));
+    }
+    return results_;
+}
+
+std::span<BatchResult> bencode::parse_batch(std::span<const std::string_view> msgs, const ParseLimits &limits) {
+    thread_local ParseContext context;
+    thread_local std::vector<BatchResult> results;
+    results.resize(msgs.size());
+    context.parse(msgs, results.data(), limits);
+    return results;
+}
@@ -0,0 +1,87 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_BATCH_H
+#define TEST_BENCODE_BATCH_H
+
+#include "config.h"
+#include "type.h"
+#include "Arena.h"
+#include "Document.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bencode {
+    struct BatchResult {
+        BView root;//empty unless error is NoError
+        size_t consumed = 0;
+        Error error = Error::ErrIvd;
+    };
+
+    //parser state for one thread: the arena holding the nodes and the scratch stacks used while
+    //containers are open.both are rewound,not freed,between batches.strings and keys are views
+    //into the messages,so no key table is needed
+    class ParseContext {
+    public:
+        //out[i] receives msgs[i],the nodes stay valid until the next call on this context
+        void parse(std::span<const std::string_view> msgs, BatchResult *out, const ParseLimits &limits = {});
+
+    private:
+        Arena arena_;
+        std::vector<BView> items_;
+        std::vector<BViewDict::value_type> entries_;
+    };
+
+    //parses batches of small messages,optionally splitting a big batch over worker threads
+    //that each own a ParseContext:
+    //  BatchParser parser(4);
+    //  for (auto &&r: parser.parse_batch(msgs)) if (r.error == Error::NoError) ...
+    class BatchParser {
+    public:
+        explicit BatchParser(size_t threads = 1, const ParseLimits &limits = {});
+
+        ~BatchParser();
+
+        BatchParser(const BatchParser &) = delete;
+
+        BatchParser &operator=(const BatchParser &) = delete;
+
+        //results are in msgs order and valid until the next parse_batch() call.an exception
+        //thrown while parsing on a worker is rethrown here once every worker has finished
+        std::span<BatchResult> parse_batch(std::span<const std::string_view> msgs);
+
+    private:
+        //below this many messages per thread the hand-off costs more than it saves
+        static constexpr size_t MinPerThread = 64;
+
+        void work(size_t id);
+
+        void run(size_t id);
+
+        ParseLimits limits_;
+        std::vector<ParseContext> contexts_;
+        std::vector<BatchResult> results_;
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        std::span<const std::string_view> msgs_;
+        size_t slice_ = 0;
+        size_t round_ = 0;
+        size_t active_ = 0;//workers with a non-empty slice this round,ids 1..active_
+        size_t pending_ = 0;
+        std::exception_ptr failure_;
+        bool stop_ = false;
+    };
+
+    //single threaded batch on a context owned by the calling thread
+    std::span<BatchResult> parse_batch(std::span<const std::string_view> msgs, const ParseLimits &limits = {});
+}
+
+#endif //TEST_BENCODE_BATCH_H
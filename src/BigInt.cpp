@@ -0,0 +1,65 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "BigInt.h"
+#include "IntCodec.h"
+
+using bencode::BigInt;
+
+BigInt::BigInt(int64_t val) {
+    char buf[20];
+    digits_.assign(buf, FormatInt(buf, val));
+}
+
+BigInt bencode::BigInt::Parse(std::string_view text, Error *error_code) {
+    auto body = text.substr(!text.empty() && text[0] == '-');
+    bool ok = !body.empty() && (body[0] != '0' || (body.size() == 1 && body.size() == text.size()));
+    for (auto c: body) {
+        ok = ok && c >= '0' && c <= '9';
+    }
+    if (!ok) {
+        if (error_code)*error_code = Error::ErrNum;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    BigInt ret;
+    ret.digits_.assign(text);
+    return ret;
+}
+
+bool bencode::BigInt::magnitude(uint64_t *out) const {
+    auto body = std::string_view(digits_).substr(negative());
+    if (body.size() > 20) {
+        return false;
+    }
+    uint64_t u = 0;
+    for (auto c: body) {
+        uint64_t d = c - '0';
+        if (u > (UINT64_MAX - d) / 10) {
+            return false;
+        }
+        u = u * 10 + d;
+    }
+    *out = u;
+    return true;
+}
+
+double bencode::BigInt::to_double() const {
+    double ret = 0;
+    for (auto c: std::string_view(digits_).substr(negative())) {
+        ret = ret * 10 + (c - '0');
+    }
+    return negative() ? -ret : ret;
+}
+
+std::strong_ordering bencode::BigInt::operator<=>(const BigInt &o) const {
+    if (negative() != o.negative()) {
+        return negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    //canonical text:more digits means larger magnitude,equal length compares like strings
+    auto a = std::string_view(digits_).substr(negative());
+    auto b = std::string_view(o.digits_).substr(o.negative());
+    auto mag = a.size() != b.size() ? a.size() <=> b.size() : a.compare(b) <=> 0;
+    return negative() ? 0 <=> mag : mag;
+}
@@ -0,0 +1,79 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_BIGINT_H
+#define TEST_BENCODE_BIGINT_H
+
+#include "type.h"
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace bencode {
+    //integer of any size kept as its canonical decimal text ("0","-12",...).
+    //bencode puts no bound on integers,parsers store the ones outside int64_t this way
+    class BigInt {
+    public:
+        BigInt() : digits_("0") {}
+
+        explicit BigInt(int64_t val);
+
+        //text must be canonical:an optional '-',no leading zeros,no "-0".ErrNum otherwise
+        static BigInt Parse(std::string_view text, Error *error_code = nullptr);
+
+        std::string_view digits() const {
+            return digits_;
+        }
+
+        bool negative() const {
+            return digits_[0] == '-';
+        }
+
+        //checked conversion,ErrNum when the value doesn't fit T
+        template<class T>
+        T as(Error *error_code = nullptr) const;
+
+        double to_double() const;
+
+        std::strong_ordering operator<=>(const BigInt &o) const;
+
+        bool operator==(const BigInt &o) const {
+            return digits_ == o.digits_;
+        }
+
+    private:
+        //absolute value,false if it needs more than 64 bits
+        bool magnitude(uint64_t *out) const;
+
+        std::string digits_;
+    };
+
+    template<class T>
+    T BigInt::as(Error *error_code) const {
+        static_assert(std::is_integral_v<T>, "BigInt converts to integer types only");
+        uint64_t u;
+        if (magnitude(&u)) {
+            if (!negative()) {
+                if (std::in_range<T>(u)) {
+                    if (error_code)*error_code = Error::NoError;
+                    return T(u);
+                }
+            } else if constexpr(std::is_signed_v<T>) {
+                //u >= 1 here,-(u - 1) - 1 reaches the minimum without overflowing
+                if (u - 1 <= uint64_t(std::numeric_limits<T>::max())) {
+                    if (error_code)*error_code = Error::NoError;
+                    return T(-T(u - 1) - 1);
+                }
+            }
+        }
+        if (error_code)*error_code = Error::ErrNum;
+        return 0;
+    }
+}
+
+#endif //TEST_BENCODE_BIGINT_H
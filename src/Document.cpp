@@ -0,0 +1,433 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Document.h"
+#include <iostream>
+#include <iterator>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BENCODE_HAS_MMAP
+#else
+#include <fstream>
+#endif
+
+using bencode::BView;
+using bencode::Document;
+
+std::string_view *bencode::BView::Str(Error *error_code) {
+    if (this->type_ != BType::BSTR) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return nullptr;
+    }
+    if (error_code)*error_code = Error::NoError;
+    return get_if<std::string_view>(&this->value_);
+}
+
+int64_t *bencode::BView::Int(Error *error_code) {
+    if (this->type_ != BType::BINT) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return nullptr;
+    }
+    auto val = get_if<int64_t>(&this->value_);
+    if (error_code)*error_code = val ? Error::NoError : Error::ErrNum;
+    return val;
+}
+
+bencode::BigInt bencode::BView::as_bigint(Error *error_code) {
+    Error error;
+    auto digits = raw_digits(&error);
+    if (error_code)*error_code = error;
+    if (error != Error::NoError) {
+        return {};
+    }
+    if (auto val = get_if<int64_t>(&this->value_)) {
+        return BigInt(*val);
+    }
+    return BigInt::Parse(digits);
+}
+
+std::string bencode::BView::raw_digits(Error *error_code) {
+    if (this->type_ != BType::BINT) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    if (auto digits = get_if<std::string_view>(&this->value_)) {
+        return std::string(*digits);
+    }
+    return std::to_string(get<int64_t>(this->value_));
+}
+
+BView::LIST *bencode::BView::List(Error *error_code) {
+    if (this->type_ != BType::BLIST) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return nullptr;
+    }
+    if (error_code)*error_code = Error::NoError;
+    return get_if<LIST>(&this->value_);
+}
+
+BView::DICT *bencode::BView::Dict(Error *error_code) {
+    if (this->type_ != BType::BDICT) {
+        if (error_code)*error_code = Error::ErrTyp;
+        return nullptr;
+    }
+    if (error_code)*error_code = Error::NoError;
+    return get_if<DICT>(&this->value_);
+}
+
+//same wire format as BObject::Bencode,strings are written straight from the borrowed buffer.
+//iterative,open containers are frames on a small stack so deep nesting can't exhaust the thread stack
+int bencode::BView::Bencode(std::ostream &os) {
+    struct Frame {
+        BView *node;
+        size_t index;
+    };
+    int wLen = 0;
+    if (!os) {
+        return wLen;
+    }
+    std::vector<Frame> stack;
+    BView *cur = this;
+    while (true) {
+        if (cur) {
+            switch (cur->type_) {
+                case BType::BSTR:
+                    if (auto str = cur->Str()) {
+                        wLen += BObject::EncodeString(os, *str);
+                    }
+                    break;
+                case BType::BINT:
+                    if (auto digits = get_if<std::string_view>(&cur->value_)) {
+                        wLen += BObject::EncodeIntDigits(os, *digits);
+                    } else if (auto val = cur->Int()) {
+                        wLen += BObject::EncodeInt(os, *val);
+                    }
+                    break;
+                case BType::BLIST:
+                case BType::BDICT:
+                    if (cur->List() || cur->Dict()) {
+                        os << (cur->type_ == BType::BLIST ? 'l' : 'd');
+                        wLen++;
+                        stack.push_back({cur, 0});
+                    }
+                    break;
+            }
+            cur = nullptr;
+        }
+        if (stack.empty()) {
+            break;
+        }
+        auto &top = stack.back();
+        if (auto list = top.node->List()) {
+            if (top.index < list->size()) {
+                cur = &(*list)[top.index++];
+                continue;
+            }
+        } else if (auto dict = top.node->Dict(); top.index < dict->size()) {
+            auto &entry = dict->begin()[top.index++];
+            wLen += BObject::EncodeString(os, entry.first);
+            cur = &entry.second;
+            continue;
+        }
+        os << 'e';
+        wLen++;
+        stack.pop_back();
+    }
+    return wLen;
+}
+
+//iterative like Bencode:a container is built once all of its children are,finished children
+//wait on one value stack and are moved into their parent when it closes
+std::shared_ptr<bencode::BObject> bencode::BView::to_object() {
+    struct Frame {
+        BView *node;
+        size_t index;
+        size_t start;
+    };
+    std::vector<Frame> stack;
+    std::vector<std::shared_ptr<BObject>> done;
+    BView *cur = this;
+    while (true) {
+        if (cur) {
+            std::shared_ptr<BObject> value;
+            switch (cur->type_) {
+                case BType::BSTR:
+                    if (auto str = cur->Str()) {
+                        value = std::make_shared<BObject>(std::string(*str));
+                    }
+                    break;
+                case BType::BINT:
+                    if (auto digits = get_if<std::string_view>(&cur->value_)) {
+                        value = std::make_shared<BObject>(BigInt::Parse(*digits));
+                    } else if (auto val = cur->Int()) {
+                        value = std::make_shared<BObject>(*val);
+                    }
+                    break;
+                case BType::BLIST:
+                case BType::BDICT:
+                    if (cur->List() || cur->Dict()) {
+                        stack.push_back({cur, 0, done.size()});
+                        cur = nullptr;
+                        continue;
+                    }
+                    break;
+            }
+            if (!value) {
+                return nullptr;
+            }
+            done.push_back(std::move(value));
+            cur = nullptr;
+        }
+        if (stack.empty()) {
+            break;
+        }
+        auto &top = stack.back();
+        std::shared_ptr<BObject> value;
+        if (auto items = top.node->List()) {
+            if (top.index < items->size()) {
+                cur = &(*items)[top.index++];
+                continue;
+            }
+            BObject::LIST list(std::make_move_iterator(done.begin() + top.start),
+                               std::make_move_iterator(done.end()));
+            value = std::make_shared<BObject>(std::move(list));
+        } else {
+            auto src = top.node->Dict();
+            if (top.index < src->size()) {
+                cur = &src->begin()[top.index++].second;
+                continue;
+            }
+            BObject::DICT dict;
+            auto child = done.begin() + top.start;
+            for (auto &&entry: *src) {
+                dict.emplace(InputKey(entry.first), std::move(*child++));
+            }
+            value = std::make_shared<BObject>(std::move(dict));
+        }
+        done.resize(top.start);
+        done.push_back(std::move(value));
+        stack.pop_back();
+    }
+    return done.empty() ? nullptr : std::move(done.back());
+}
+
+//parse state shared by all nesting levels:children are collected on the scratch stacks and
+//moved into the arena in one piece when their container closes,so siblings end up contiguous
+struct bencode::Document::Builder {
+    Arena &arena;
+    const ParseLimits &limits;
+    std::vector<BView> &items;
+    std::vector<BViewDict::value_type> &entries;
+    size_t nodes = 0;
+
+    bool parse(BView &root, const char *&cur, const char *end, Error *error);
+};
+
+//iterative,open containers are frames on a small stack so hostile nesting fails with ErrDep at
+//limits.max_depth instead of exhausting the thread stack.no byte of a string is copied
+bool bencode::Document::Builder::parse(BView &root, const char *&cur, const char *end, Error *error) {
+    struct Frame {
+        size_t start;//first child on items or entries
+        std::string_view key;//key of the value being parsed,dicts only
+        bool dict;
+        bool sorted;
+    };
+    std::vector<Frame> stack;
+    //hands a finished value to the open container,true once the root is done
+    auto place = [&](const BView &val) {
+        if (stack.empty()) {
+            root = val;
+            return true;
+        }
+        auto &top = stack.back();
+        if (!top.dict) {
+            items.push_back(val);
+        } else {
+            if (entries.size() > top.start && !(entries.back().first < top.key)) {
+                top.sorted = false;
+            }
+            entries.emplace_back(top.key, val);
+        }
+        return false;
+    };
+    while (true) {
+        if (!stack.empty()) {
+            auto &top = stack.back();
+            if (cur == end) {
+                *error = Error::ErrEpE;
+                return false;
+            }
+            if (*cur == 'e') {
+                cur++;
+                BView obj;
+                if (top.dict) {
+                    auto n = entries.size() - top.start;
+                    auto data = arena.allocate_array<BViewDict::value_type>(n);
+                    std::uninitialized_copy(entries.begin() + top.start, entries.end(), data);
+                    entries.resize(top.start);
+                    obj.type_ = BType::BDICT;
+                    obj.value_ = BViewDict(data, n, top.sorted);
+                } else {
+                    auto n = items.size() - top.start;
+                    auto data = arena.allocate_array<BView>(n);
+                    std::uninitialized_copy(items.begin() + top.start, items.end(), data);
+                    items.resize(top.start);
+                    obj.type_ = BType::BLIST;
+                    obj.value_ = BViewList(data, n);
+                }
+                stack.pop_back();
+                if (place(obj)) {
+                    break;
+                }
+                continue;
+            }
+            if (top.dict) {
+                top.key = BObject::DecodeString(cur, end, error);
+                if (*error != Error::NoError) {
+                    return false;
+                }
+            }
+        }
+        if (cur == end) {
+            *error = Error::ErrIvd;
+            return false;
+        }
+        if (++nodes > limits.max_nodes) {
+            *error = Error::ErrCnt;
+            return false;
+        }
+        auto x = *cur;
+        BView val;
+        if (x >= '0' && x <= '9') {//parse string
+            auto str = BObject::DecodeString(cur, end, error);
+            if (*error != Error::NoError) {
+                return false;
+            }
+            val.type_ = BType::BSTR;
+            val.value_ = str;
+        } else if (x == 'i') {//parse int,one outside int64_t keeps a view of its digits
+            auto num = BObject::DecodeInt(cur, end, error);
+            if (*error == Error::ErrNum) {
+                auto digits = BObject::DecodeIntDigits(cur, end, error);
+                if (*error != Error::NoError) {
+                    return false;
+                }
+                val.type_ = BType::BINT;
+                val.value_ = digits;
+            } else if (*error != Error::NoError) {
+                return false;
+            } else {
+                val.type_ = BType::BINT;
+                val.value_ = num;
+            }
+        } else if (x == 'l' || x == 'd') {//open a container,its children follow
+            if (stack.size() >= limits.max_depth) {
+                *error = Error::ErrDep;
+                return false;
+            }
+            cur++;
+            stack.push_back({x == 'd' ? entries.size() : items.size(), {}, x == 'd', true});
+            continue;
+        } else {
+            *error = Error::ErrIvd;
+            return false;
+        }
+        if (place(val)) {
+            break;
+        }
+    }
+    *error = Error::NoError;
+    return true;
+}
+
+bool bencode::Document::parseInto(BView &root, std::string_view in, Arena &arena, std::vector<BView> &items,
+                                  std::vector<BViewDict::value_type> &entries, Error *error, size_t *consumed,
+                                  const ParseLimits &limits) {
+    Builder builder{arena, limits, items, entries};
+    Error err;
+    auto cur = in.data();
+    bool ok = builder.parse(root, cur, in.data() + in.size(), &err);
+    if (!ok) {//a failure leaves the children of unclosed containers behind
+        items.clear();
+        entries.clear();
+    }
+    if (error)*error = err;
+    if (consumed)*consumed = ok ? cur - in.data() : 0;
+    return ok;
+}
+
+Document bencode::Document::Parse(std::string_view in, Error *error, size_t *consumed,
+                                  const ParseLimits &limits) {
+    Document doc;
+    std::vector<BView> items;
+    std::vector<BViewDict::value_type> entries;
+    size_t used;
+    if (!parseInto(doc.root_, in, doc.arena_, items, entries, error, &used, limits)) {
+        if (consumed)*consumed = 0;
+        return {};
+    }
+    if (consumed)*consumed = used;
+    doc.buf_ = std::string_view(in.data(), used);
+    return doc;
+}
+
+Document bencode::Document::open_mapped(const std::string &path, Error *error, const ParseLimits &limits) {
+    std::shared_ptr<const char> mapping;
+    size_t size;
+#ifdef BENCODE_HAS_MMAP
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error)*error = Error::ErrSys;
+        return {};
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        if (error)*error = Error::ErrSys;
+        return {};
+    }
+    size = st.st_size;
+    if (size == 0) {//mmap rejects empty files,and there is no value in one anyway
+        ::close(fd);
+        if (error)*error = Error::ErrIvd;
+        return {};
+    }
+    auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);//the mapping keeps its own reference to the file
+    if (addr == MAP_FAILED) {
+        if (error)*error = Error::ErrSys;
+        return {};
+    }
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+    mapping = std::shared_ptr<const char>(static_cast<const char *>(addr), [size](const char *p) {
+        ::munmap(const_cast<char *>(p), size);
+    });
+#else
+    //no mmap,read the file into one heap block the Document owns instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        if (error)*error = Error::ErrSys;
+        return {};
+    }
+    size = file.tellg();
+    std::shared_ptr<char> data(new char[size], std::default_delete<char[]>());
+    file.seekg(0);
+    if (!file.read(data.get(), size)) {
+        if (error)*error = Error::ErrSys;
+        return {};
+    }
+    mapping = std::move(data);
+#endif
+    auto doc = Parse(std::string_view(mapping.get(), size), error, nullptr, limits);
+    if (!doc.buf_.empty()) {
+        doc.mapping_ = std::move(mapping);
+    }
+    return doc;
+}
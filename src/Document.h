@@ -0,0 +1,245 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_DOCUMENT_H
+#define TEST_BENCODE_DOCUMENT_H
+
+#include "config.h"
+#include "type.h"
+#include "Arena.h"
+#include "BObject.h"
+#include <memory>
+#include <variant>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bencode {
+    class BView;
+
+    //children of a list node,a plain array living in the Document's arena
+    class BViewList {
+    public:
+        BViewList() = default;
+
+        BViewList(BView *data, size_t size) : data_(data), size_(size) {}
+
+        BView *begin() const { return data_; }
+
+        BView *end() const;
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        BView &operator[](size_t index) const;
+
+        BView &at(size_t index) const;
+
+    private:
+        BView *data_{};
+        size_t size_{};
+    };
+
+    //entries of a dict node in input order,a plain array living in the Document's arena
+    class BViewDict {
+    public:
+        using value_type = std::pair<std::string_view, BView>;
+
+        BViewDict() = default;
+
+        BViewDict(value_type *data, size_t size, bool sorted) : data_(data), size_(size), sorted_(sorted) {}
+
+        value_type *begin() const { return data_; }
+
+        value_type *end() const;
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        //binary search when the keys came in canonical order,linear scan otherwise
+        value_type *find(std::string_view key) const;
+
+        size_t count(std::string_view key) const;
+
+    private:
+        value_type *data_{};
+        size_t size_{};
+        bool sorted_{};
+    };
+
+    //a node of a borrowed Document,string values and dict keys are views into the parsed buffer
+    class BView {
+    public:
+        using LIST = BViewList;
+        using DICT = BViewDict;
+        //a BINT holding a string_view is an integer outside int64_t,kept as its digits
+        using BValue = std::variant<int64_t, std::string_view, LIST, DICT>;
+
+        friend class Document;
+
+        BView() = default;
+
+        std::string_view *Str(Error *error_code = nullptr);
+
+        //ErrNum if the integer doesn't fit int64_t,see as_bigint()
+        int64_t *Int(Error *error_code = nullptr);
+
+        //checked integer conversion,ErrTyp for a non integer,ErrNum when the value doesn't fit T
+        template<class T>
+        T as(Error *error_code = nullptr) {
+            static_assert(std::is_integral_v<T>, "as<T>() converts to integer types only");
+            Error error;
+            auto val = Int(&error);
+            if (error == Error::ErrNum) {
+                return as_bigint().template as<T>(error_code);
+            }
+            if (error == Error::NoError && !std::in_range<T>(*val)) {
+                error = Error::ErrNum;
+            }
+            if (error_code)*error_code = error;
+            return error == Error::NoError ? T(*val) : 0;
+        }
+
+        BigInt as_bigint(Error *error_code = nullptr);
+
+        std::string raw_digits(Error *error_code = nullptr);
+
+        LIST *List(Error *error_code = nullptr);
+
+        DICT *Dict(Error *error_code = nullptr);
+
+        int Bencode(std::ostream &os);
+
+        //deep copy into an owning BObject tree
+        std::shared_ptr<BObject> to_object();
+
+        template<class T>
+        T value() {
+            if constexpr(isInteger<T>::value) {
+                auto ptr = Int();
+                if (!ptr) {
+                    throw std::runtime_error("BView value() error,change to int failed!");
+                }
+                return T(*ptr);
+            } else if constexpr(isString<T>::value || isStringView<T>::value) {
+                auto ptr = Str();
+                if (!ptr) {
+                    throw std::runtime_error("BView value() error,change to string failed!");
+                }
+                return T(*ptr);
+            } else if constexpr(std::is_same_v<T, LIST>) {
+                auto ptr = List();
+                if (!ptr) {
+                    throw std::runtime_error("BView value() error,change to List failed!");
+                }
+                return *ptr;
+            } else if constexpr(std::is_same_v<T, DICT>) {
+                auto ptr = Dict();
+                if (!ptr) {
+                    throw std::runtime_error("BView value() error,change to Dict failed!");
+                }
+                return *ptr;
+            } else {
+                throw std::runtime_error("BView value() error,no exist type");
+            }
+        }
+
+    private:
+        //a default node is the empty string,so the type and the value always agree
+        BType type_ = BType::BSTR;
+        BValue value_{std::string_view()};
+    };
+
+    //BViewList/BViewDict members that need the complete BView
+    inline BView *BViewList::end() const {
+        return data_ + size_;
+    }
+
+    inline BView &BViewList::operator[](size_t index) const {
+        return data_[index];
+    }
+
+    inline BView &BViewList::at(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("BViewList at() out of range");
+        }
+        return data_[index];
+    }
+
+    inline BViewDict::value_type *BViewDict::end() const {
+        return data_ + size_;
+    }
+
+    inline size_t BViewDict::count(std::string_view key) const {
+        return find(key) != end();
+    }
+
+    inline BViewDict::value_type *BViewDict::find(std::string_view key) const {
+        if (sorted_ && size_ > 8) {
+            auto lo = data_, hi = data_ + size_;
+            while (lo < hi) {
+                auto mid = lo + (hi - lo) / 2;
+                if (mid->first < key) lo = mid + 1;
+                else hi = mid;
+            }
+            return (lo != end() && lo->first == key) ? lo : end();
+        }
+        for (auto it = data_; it != end(); ++it) {
+            if (it->first == key) return it;
+        }
+        return end();
+    }
+
+    //parse result that borrows the input buffer instead of copying strings out of it,
+    //the caller must keep the buffer alive and unchanged while the Document is used.
+    //all nodes live in one Arena and are freed together with the Document
+    class Document {
+    public:
+        Document() = default;
+
+        static Document Parse(std::string_view in, Error *error, size_t *consumed = nullptr,
+                              const ParseLimits &limits = {});
+
+        //map the file read-only and parse straight out of the mapping,string nodes point into it
+        //and it is unmapped together with the Document.ErrSys when the file can't be opened or mapped
+        static Document open_mapped(const std::string &path, Error *error, const ParseLimits &limits = {});
+
+        BView &root() {
+            return root_;
+        }
+
+        std::string_view buffer() const {
+            return buf_;
+        }
+
+        //nothing is written for a Document holding no value,e.g. after a failed Parse
+        int Bencode(std::ostream &os) {
+            if (buf_.empty()) {
+                return 0;
+            }
+            return root_.Bencode(os);
+        }
+
+    private:
+        friend class ParseContext;
+
+        struct Builder;
+
+        //parse one value into root,containers go to arena and the scratch stacks are left empty
+        static bool parseInto(BView &root, std::string_view in, Arena &arena, std::vector<BView> &items,
+                              std::vector<BViewDict::value_type> &entries, Error *error, size_t *consumed,
+                              const ParseLimits &limits);
+
+        std::string_view buf_;
+        std::shared_ptr<const char> mapping_;//set by open_mapped()
+        Arena arena_;
+        BView root_;
+    };
+}
+
+#endif //TEST_BENCODE_DOCUMENT_H
@@ -0,0 +1,160 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_FLATMAP_H
+#define TEST_BENCODE_FLATMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bencode {
+    //sorted vector of pairs with the parts of the std::map interface the library uses,
+    //selected as __DICT__ by F_DICT.dicts are small,so one contiguous block beats a node per key,
+    //and iteration is in key order,which is what bencode requires.keys arriving in ascending
+    //order,as in any canonical input,are appended without a search
+    template<class K, class V, class Compare = std::less<>>
+    class FlatMap {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using size_type = size_t;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        FlatMap() = default;
+
+        FlatMap(std::initializer_list<value_type> init) {
+            for (auto &&item: init) {
+                emplace(item.first, item.second);
+            }
+        }
+
+        iterator begin() { return items_.begin(); }
+
+        iterator end() { return items_.end(); }
+
+        const_iterator begin() const { return items_.begin(); }
+
+        const_iterator end() const { return items_.end(); }
+
+        size_t size() const { return items_.size(); }
+
+        bool empty() const { return items_.empty(); }
+
+        void clear() { items_.clear(); }
+
+        void reserve(size_t n) { items_.reserve(n); }
+
+        template<class Key>
+        iterator lower_bound(const Key &key) {
+            return std::lower_bound(items_.begin(), items_.end(), key, [this](const value_type &item, const Key &k) {
+                return comp_(item.first, k);
+            });
+        }
+
+        template<class Key>
+        const_iterator lower_bound(const Key &key) const {
+            return const_cast<FlatMap *>(this)->lower_bound(key);
+        }
+
+        template<class Key>
+        iterator find(const Key &key) {
+            auto it = lower_bound(key);
+            return it != end() && !comp_(key, it->first) ? it : end();
+        }
+
+        template<class Key>
+        const_iterator find(const Key &key) const {
+            return const_cast<FlatMap *>(this)->find(key);
+        }
+
+        template<class Key>
+        size_t count(const Key &key) const {
+            return find(key) != end();
+        }
+
+        template<class Key>
+        bool contains(const Key &key) const {
+            return find(key) != end();
+        }
+
+        //like std::map:an existing key is left alone
+        template<class Key, class... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+            auto it = end();
+            if (!items_.empty() && !comp_(items_.back().first, key)) {
+                it = lower_bound(key);
+                if (it != end() && !comp_(key, it->first)) {
+                    return {it, false};
+                }
+            }
+            it = items_.emplace(it, std::piecewise_construct, std::forward_as_tuple(K(std::forward<Key>(key))),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+            return {it, true};
+        }
+
+        template<class Key, class Value>
+        std::pair<iterator, bool> emplace(Key &&key, Value &&value) {
+            return try_emplace(std::forward<Key>(key), std::forward<Value>(value));
+        }
+
+        template<class Pair>
+        std::pair<iterator, bool> insert(Pair &&item) {
+            return try_emplace(std::forward<Pair>(item).first, std::forward<Pair>(item).second);
+        }
+
+        template<class Key>
+        V &operator[](Key &&key) {
+            return try_emplace(std::forward<Key>(key)).first->second;
+        }
+
+        template<class Key>
+        V &at(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                throw std::out_of_range("FlatMap at() no such key");
+            }
+            return it->second;
+        }
+
+        template<class Key>
+        const V &at(const Key &key) const {
+            return const_cast<FlatMap *>(this)->at(key);
+        }
+
+        iterator erase(iterator pos) {
+            return items_.erase(pos);
+        }
+
+        iterator erase(const_iterator pos) {
+            return items_.erase(pos);
+        }
+
+        template<class Key>
+        size_t erase(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                return 0;
+            }
+            items_.erase(it);
+            return 1;
+        }
+
+        bool operator==(const FlatMap &other) const {
+            return items_ == other.items_;
+        }
+
+    private:
+        std::vector<value_type> items_;
+        [[no_unique_address]] Compare comp_;
+    };
+}
+
+#endif //TEST_BENCODE_FLATMAP_H
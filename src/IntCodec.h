@@ -0,0 +1,91 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_INTCODEC_H
+#define TEST_BENCODE_INTCODEC_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//integer <-> decimal helpers shared by the decoders and encoders
+namespace bencode {
+    inline constexpr char DigitPairs[] =
+            "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+            "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+    //decimal digits of v
+    inline int UintLength(uint64_t v) {
+        int n = 1;
+        while (true) {
+            if (v < 10) return n;
+            if (v < 100) return n + 1;
+            if (v < 1000) return n + 2;
+            if (v < 10000) return n + 3;
+            v /= 10000;
+            n += 4;
+        }
+    }
+
+    //characters needed to print val,the '-' included
+    inline int IntLength(int64_t val) {
+        return val < 0 ? 1 + UintLength(0 - uint64_t(val)) : UintLength(val);
+    }
+
+    //write val in decimal to out without a terminator,returns the characters written (at most 20).
+    //two digits are produced per division
+    inline size_t FormatInt(char *out, int64_t val) {
+        auto p = out;
+        uint64_t u = val;
+        if (val < 0) {
+            *p++ = '-';
+            u = 0 - u;
+        }
+        auto n = UintLength(u);
+        auto q = p + n;
+        while (u >= 100) {
+            auto i = (u % 100) * 2;
+            u /= 100;
+            q -= 2;
+            std::memcpy(q, DigitPairs + i, 2);
+        }
+        if (u < 10) {
+            *--q = char('0' + u);
+        } else {
+            q -= 2;
+            std::memcpy(q, DigitPairs + u * 2, 2);
+        }
+        return p + n - out;
+    }
+
+    //SWAR helpers over eight characters loaded little endian,the first character in the low byte
+    inline constexpr bool SwarDigits = std::endian::native == std::endian::little;
+
+    inline uint64_t LoadEight(const char *p) {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, 8);
+        return chunk;
+    }
+
+    //how many leading characters of chunk are '0'-'9'
+    inline int DigitRun(uint64_t chunk) {
+        auto a = chunk ^ 0x3030303030303030ULL;
+        //a byte is a digit iff it is now below 10,adding 6 pushes 10..15 into the high nibble.
+        //a carry only leaks into bytes after a non digit,which don't matter
+        auto bad = (a | (a + 0x0606060606060606ULL)) & 0xF0F0F0F0F0F0F0F0ULL;
+        return bad ? std::countr_zero(bad) / 8 : 8;
+    }
+
+    //value of the first n (1..8) characters of chunk,which must all be digits
+    inline uint32_t ParseDigits(uint64_t chunk, int n) {
+        //move the digits to the top so the missing ones act as leading zeros
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - n));
+        chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+        chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+        return uint32_t((chunk * 10000 + (chunk >> 32)));
+    }
+}
+
+#endif //TEST_BENCODE_INTCODEC_H
@@ -0,0 +1,196 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "LazyValue.h"
+#include "Reader.h"
+
+using bencode::BObject;
+using bencode::LazyValue;
+
+namespace {
+    //Reader handler that drops every token,only the bytes consumed matter
+    struct Skipper {
+        void on_int(int64_t) {}
+
+        void on_bigint(std::string_view) {}
+
+        void on_string(std::string_view) {}
+
+        void on_key(std::string_view) {}
+
+        void on_list_begin() {}
+
+        void on_list_end() {}
+
+        void on_dict_begin() {}
+
+        void on_dict_end() {}
+    };
+}
+
+bool bencode::LazyValue::skip(const char *&cur, const char *end, Error *error) {
+    auto x = *cur;
+    if (x >= '0' && x <= '9') {//most skipped values are strings,jump without going through Reader
+        BObject::DecodeString(cur, end, error);
+        return *error == Error::NoError;
+    }
+    Skipper skipper;
+    size_t consumed;
+    if (!Reader::Parse(std::string_view(cur, end - cur), skipper, error, &consumed)) {
+        return false;
+    }
+    cur += consumed;
+    return true;
+}
+
+bencode::BType bencode::LazyValue::type(Error *error_code) const {
+    if (error_code)*error_code = error_;
+    if (error_ != Error::NoError) {
+        return BType::BSTR;
+    }
+    switch (*cur_) {
+        case 'i':
+            return BType::BINT;
+        case 'l':
+            return BType::BLIST;
+        case 'd':
+            return BType::BDICT;
+        default:
+            if (*cur_ >= '0' && *cur_ <= '9') {
+                return BType::BSTR;
+            }
+            if (error_code)*error_code = Error::ErrIvd;
+            return BType::BSTR;
+    }
+}
+
+bencode::LazyValue bencode::LazyValue::operator[](std::string_view key) const {
+    if (error_ != Error::NoError) {
+        return *this;
+    }
+    if (*cur_ != 'd') {
+        return {cur_, end_, Error::ErrTyp};
+    }
+    Error error;
+    auto p = cur_ + 1;
+    while (true) {
+        if (p == end_) {
+            return {p, end_, Error::ErrEpE};
+        }
+        if (*p == 'e') {
+            return {p, end_, Error::ErrNfd};
+        }
+        auto k = BObject::DecodeString(p, end_, &error);
+        if (error != Error::NoError) {
+            return {p, end_, error};
+        }
+        if (p == end_) {
+            return {p, end_, Error::ErrIvd};
+        }
+        if (k == key) {
+            return {p, end_, Error::NoError};
+        }
+        if (!skip(p, end_, &error)) {
+            return {p, end_, error};
+        }
+    }
+}
+
+bencode::LazyValue bencode::LazyValue::operator[](size_t index) const {
+    if (error_ != Error::NoError) {
+        return *this;
+    }
+    if (*cur_ != 'l') {
+        return {cur_, end_, Error::ErrTyp};
+    }
+    Error error;
+    auto p = cur_ + 1;
+    while (true) {
+        if (p == end_) {
+            return {p, end_, Error::ErrEpE};
+        }
+        if (*p == 'e') {
+            return {p, end_, Error::ErrNfd};
+        }
+        if (index-- == 0) {
+            return {p, end_, Error::NoError};
+        }
+        if (!skip(p, end_, &error)) {
+            return {p, end_, error};
+        }
+    }
+}
+
+std::string_view bencode::LazyValue::Str(Error *error_code) const {
+    Error error = error_;
+    std::string_view str;
+    if (error == Error::NoError) {
+        if (*cur_ >= '0' && *cur_ <= '9') {
+            auto p = cur_;
+            str = BObject::DecodeString(p, end_, &error);
+        } else {
+            error = Error::ErrTyp;
+        }
+    }
+    if (error_code)*error_code = error;
+    return str;
+}
+
+int64_t bencode::LazyValue::Int(Error *error_code) const {
+    Error error = error_;
+    int64_t val = 0;
+    if (error == Error::NoError) {
+        if (*cur_ == 'i') {
+            auto p = cur_;
+            val = BObject::DecodeInt(p, end_, &error);
+        } else {
+            error = Error::ErrTyp;
+        }
+    }
+    if (error_code)*error_code = error;
+    return val;
+}
+
+std::string_view bencode::LazyValue::raw_digits(Error *error_code) const {
+    Error error = error_;
+    std::string_view digits;
+    if (error == Error::NoError) {
+        if (*cur_ == 'i') {
+            auto p = cur_;
+            digits = BObject::DecodeIntDigits(p, end_, &error);
+        } else {
+            error = Error::ErrTyp;
+        }
+    }
+    if (error_code)*error_code = error;
+    return digits;
+}
+
+bencode::BigInt bencode::LazyValue::as_bigint(Error *error_code) const {
+    Error error;
+    auto digits = raw_digits(&error);
+    if (error_code)*error_code = error;
+    return error == Error::NoError ? BigInt::Parse(digits) : BigInt();
+}
+
+std::string_view bencode::LazyValue::raw(Error *error_code) const {
+    Error error = error_;
+    std::string_view bytes;
+    if (error == Error::NoError) {
+        auto p = cur_;
+        if (skip(p, end_, &error)) {
+            bytes = {cur_, size_t(p - cur_)};
+        }
+    }
+    if (error_code)*error_code = error;
+    return bytes;
+}
+
+std::shared_ptr<BObject> bencode::LazyValue::to_object(Error *error_code) const {
+    if (error_ != Error::NoError) {
+        if (error_code)*error_code = error_;
+        return nullptr;
+    }
+    return BObject::Parse(std::string_view(cur_, end_ - cur_), error_code);
+}
@@ -0,0 +1,119 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_LAZYVALUE_H
+#define TEST_BENCODE_LAZYVALUE_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace bencode {
+    //on-demand view of a value inside a raw buffer,nothing is parsed up front:
+    //  auto name = lazy_parse(buf)["info"]["name"].get<std::string_view>();
+    //a lookup only scans the entries in front of the one it wants,strings are jumped over
+    //by their length prefix.a failed lookup yields a value whose error() says why,
+    //indexing it further keeps that error
+    class LazyValue {
+    public:
+        LazyValue() = default;
+
+        explicit LazyValue(std::string_view buf)
+                : cur_(buf.data()), end_(buf.data() + buf.size()),
+                  error_(buf.empty() ? Error::ErrIvd : Error::NoError) {}
+
+        Error error() const {
+            return error_;
+        }
+
+        //meaningless unless *error_code comes back as NoError
+        BType type(Error *error_code = nullptr) const;
+
+        //dict entry,the first occurrence wins if the key repeats
+        LazyValue operator[](std::string_view key) const;
+
+        //list element
+        LazyValue operator[](size_t index) const;
+
+        std::string_view Str(Error *error_code = nullptr) const;
+
+        int64_t Int(Error *error_code = nullptr) const;
+
+        //checked integer conversion,ErrTyp for a non integer,ErrNum when the value doesn't fit T
+        template<class T>
+        T as(Error *error_code = nullptr) const;
+
+        BigInt as_bigint(Error *error_code = nullptr) const;
+
+        //the text between 'i' and 'e',no size limit
+        std::string_view raw_digits(Error *error_code = nullptr) const;
+
+        //the encoded bytes of this value,e.g. to hash an info dict
+        std::string_view raw(Error *error_code = nullptr) const;
+
+        std::shared_ptr<BObject> to_object(Error *error_code = nullptr) const;
+
+        template<class T>
+        T get() const;
+
+    private:
+        LazyValue(const char *cur, const char *end, Error error) : cur_(cur), end_(end), error_(error) {}
+
+        //move cur past one complete value
+        static bool skip(const char *&cur, const char *end, Error *error);
+
+        const char *cur_{};
+        const char *end_{};
+        Error error_ = Error::ErrIvd;
+    };
+
+    inline LazyValue lazy_parse(std::string_view buf) {
+        return LazyValue(buf);
+    }
+
+    template<class T>
+    T LazyValue::as(Error *error_code) const {
+        static_assert(std::is_integral_v<T>, "as<T>() converts to integer types only");
+        Error error;
+        auto val = Int(&error);
+        if (error == Error::ErrNum) {//maybe just too big for int64_t
+            auto big = as_bigint(&error);
+            if (error == Error::NoError) {
+                return big.template as<T>(error_code);
+            }
+        }
+        if (error == Error::NoError && !std::in_range<T>(val)) {
+            error = Error::ErrNum;
+        }
+        if (error_code)*error_code = error;
+        return error == Error::NoError ? T(val) : 0;
+    }
+
+    template<class T>
+    T LazyValue::get() const {
+        Error error;
+        if constexpr(isInteger<T>::value) {
+            auto val = Int(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("LazyValue get() error,change to int failed!");
+            }
+            return T(val);
+        } else if constexpr(isString<T>::value || isStringView<T>::value) {
+            auto str = Str(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("LazyValue get() error,change to string failed!");
+            }
+            return T(str);
+        } else {
+            throw std::runtime_error("LazyValue get() error,no exist type");
+        }
+    }
+}
+
+#endif //TEST_BENCODE_LAZYVALUE_H
@@ -0,0 +1,75 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Path.h"
+#include <string>
+
+using bencode::Path;
+
+Path bencode::Path::compile(std::string_view path, Error *error) {
+    Path compiled;
+    auto fail = [&](Error err) {
+        if (error)*error = err;
+        return Path();
+    };
+    size_t i = 0;
+    while (i < path.size()) {
+        if (!compiled.segments_.empty()) {
+            //after a segment comes '.' and a key,or straight a '['
+            if (path[i] == '.') {
+                if (++i == path.size()) {
+                    return fail(Error::ErrIvd);
+                }
+            } else if (path[i] != '[') {
+                return fail(Error::ErrIvd);
+            }
+        }
+        Segment seg{Segment::Kind::Key, 0, {}};
+        if (path[i] == '[') {
+            auto close = path.find(']', i);
+            if (close == std::string_view::npos || close == i + 1) {
+                return fail(Error::ErrIvd);
+            }
+            auto inner = path.substr(i + 1, close - i - 1);
+            if (inner == "*") {
+                seg.kind = Segment::Kind::Any;
+            } else {
+                seg.kind = Segment::Kind::Index;
+                for (auto c: inner) {
+                    if (c < '0' || c > '9' || seg.index > (SIZE_MAX - 9) / 10) {
+                        return fail(Error::ErrIvd);
+                    }
+                    seg.index = seg.index * 10 + (c - '0');
+                }
+            }
+            i = close + 1;
+        } else {
+            std::string key;
+            bool escaped = false;
+            for (; i < path.size() && path[i] != '.' && path[i] != '['; i++) {
+                if (path[i] == '\\') {
+                    if (++i == path.size()) {
+                        return fail(Error::ErrIvd);
+                    }
+                    escaped = true;
+                }
+                key.push_back(path[i]);
+            }
+            if (key.empty()) {
+                return fail(Error::ErrIvd);
+            }
+            if (key == "*" && !escaped) {
+                seg.kind = Segment::Kind::Any;
+            } else {
+                seg.key = __KEY__(key);
+            }
+        }
+        if (seg.kind == Segment::Kind::Any && ++compiled.wildcards_ > MaxWildcards) {
+            return fail(Error::ErrCnt);
+        }
+        compiled.segments_.push_back(std::move(seg));
+    }
+    if (error)*error = Error::NoError;
+    return compiled;
+}
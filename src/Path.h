@@ -0,0 +1,285 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_PATH_H
+#define TEST_BENCODE_PATH_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include "Document.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace bencode {
+    //a chain of dict keys and list indexes parsed once and evaluated against many trees:
+    //  auto length = compile_path("info.files[*].length");
+    //  for (auto &&doc: docs)
+    //      for (auto node: length.each(*doc)) total += *node->Int();
+    //segments are separated by '.',"[3]" is a list index and "[*]" or a bare "*" matches every
+    //element of a list or every value of a dict.'\' makes the next character part of the key.
+    //keys are built once as the dict key type,so with I_KEY they are interned Symbols and a
+    //lookup compares pointers.evaluating allocates nothing,wildcards are tracked in a fixed
+    //array of MaxWildcards frames
+    class Path {
+    public:
+        static constexpr size_t MaxWildcards = 8;
+
+        struct Segment {
+            enum class Kind : uint8_t {
+                Key,
+                Index,
+                Any
+            };
+
+            Kind kind;
+            size_t index;
+            __KEY__ key;
+        };
+
+        template<class Node>
+        class Matches;
+
+        //matches the root itself
+        Path() = default;
+
+        //ErrIvd for a malformed path,ErrCnt for more than MaxWildcards wildcards
+        static Path compile(std::string_view path, Error *error = nullptr);
+
+        const std::vector<Segment> &segments() const {
+            return segments_;
+        }
+
+        bool has_wildcard() const {
+            return wildcards_ != 0;
+        }
+
+        //the first match in document order,nullptr when nothing matches
+        BObject *find(BObject &root) const;
+
+        BView *find(BView &root) const;
+
+        BView *find(Document &doc) const {
+            return find(doc.root());
+        }
+
+        //every match in document order.the range points at this Path,which must outlive it
+        Matches<BObject> each(BObject &root) const;
+
+        Matches<BView> each(BView &root) const;
+
+        Matches<BView> each(Document &doc) const;
+
+    private:
+        //find() without the wildcard frames when there are none
+        template<class Node>
+        Node *walk(Node &root) const;
+
+        std::vector<Segment> segments_;
+        size_t wildcards_ = 0;
+    };
+
+    inline Path compile_path(std::string_view path, Error *error = nullptr) {
+        return Path::compile(path, error);
+    }
+
+    //how a Path steps through each tree type
+    template<class Node>
+    struct PathTraits;
+
+    template<>
+    struct PathTraits<BObject> {
+        using List = BObject::LIST;
+        using Dict = BObject::DICT;
+
+        static BObject *node(const std::shared_ptr<BObject> &item) { return item.get(); }
+
+        static BObject *value(Dict::iterator it) { return it->second.get(); }
+
+        static BObject *key(BObject &node, const __KEY__ &key) {
+            auto dict = node.Dict();
+            if (!dict) return nullptr;
+            auto it = dict->find(key);
+            return it == dict->end() ? nullptr : it->second.get();
+        }
+    };
+
+    template<>
+    struct PathTraits<BView> {
+        using List = BViewList;
+        using Dict = BViewDict;
+
+        static BView *node(BView &item) { return &item; }
+
+        static BView *value(BViewDict::value_type *it) { return &it->second; }
+
+        static BView *key(BView &node, const __KEY__ &key) {
+            auto dict = node.Dict();
+            if (!dict) return nullptr;
+            auto it = dict->find(std::string_view(key));
+            return it == dict->end() ? nullptr : &it->second;
+        }
+    };
+
+    template<class Node>
+    class Path::Matches {
+        using Traits = PathTraits<Node>;
+        using ListIt = decltype(std::declval<typename Traits::List &>().begin());
+        using DictIt = decltype(std::declval<typename Traits::Dict &>().begin());
+
+        //a wildcard being walked,one of list/dict is set
+        struct Frame {
+            size_t seg;
+            typename Traits::List *list;
+            typename Traits::Dict *dict;
+            ListIt list_it;
+            DictIt dict_it;
+        };
+
+    public:
+        class iterator {
+        public:
+            iterator() = default;
+
+            iterator(const Path *path, Node *root) : path_(path) {
+                advance(root, 0);
+            }
+
+            Node *operator*() const { return cur_; }
+
+            iterator &operator++() {
+                advance(nullptr, 0);
+                return *this;
+            }
+
+            bool operator==(const iterator &o) const { return cur_ == o.cur_; }
+
+            bool operator!=(const iterator &o) const { return cur_ != o.cur_; }
+
+        private:
+            //first child of the frame's container,or the one after the current child
+            Node *step(Frame &f, bool first) {
+                if (f.list) {
+                    if (first) f.list_it = f.list->begin();
+                    else ++f.list_it;
+                    for (; f.list_it != f.list->end(); ++f.list_it) {
+                        if (auto child = Traits::node(*f.list_it)) return child;
+                    }
+                } else {
+                    if (first) f.dict_it = f.dict->begin();
+                    else ++f.dict_it;
+                    for (; f.dict_it != f.dict->end(); ++f.dict_it) {
+                        if (auto child = Traits::value(f.dict_it)) return child;
+                    }
+                }
+                return nullptr;
+            }
+
+            //walk the segments from seg down from node,a dead end resumes the innermost wildcard
+            //that has children left.node == nullptr starts with that resume
+            void advance(Node *node, size_t seg) {
+                auto &segs = path_->segments_;
+                while (true) {
+                    while (node && seg < segs.size()) {
+                        auto &s = segs[seg];
+                        if (s.kind == Segment::Kind::Key) {
+                            node = Traits::key(*node, s.key);
+                        } else if (s.kind == Segment::Kind::Index) {
+                            auto list = node->List();
+                            node = list && s.index < list->size() ? Traits::node((*list)[s.index]) : nullptr;
+                        } else {
+                            auto &f = frames_[depth_];
+                            f = {seg, node->List(), node->Dict(), {}, {}};
+                            if (!f.list && !f.dict) {
+                                node = nullptr;
+                                break;
+                            }
+                            depth_++;
+                            node = step(f, true);
+                            if (!node) {
+                                depth_--;
+                                break;
+                            }
+                        }
+                        seg++;
+                    }
+                    if (node) {
+                        cur_ = node;
+                        return;
+                    }
+                    while (depth_ && !node) {
+                        auto &f = frames_[depth_ - 1];
+                        node = step(f, false);
+                        if (node) {
+                            seg = f.seg + 1;
+                        } else {
+                            depth_--;
+                        }
+                    }
+                    if (!node) {
+                        cur_ = nullptr;
+                        return;
+                    }
+                }
+            }
+
+            const Path *path_{};
+            Node *cur_{};
+            size_t depth_ = 0;
+            Frame frames_[MaxWildcards];//only the first depth_ are in use
+        };
+
+        Matches(const Path *path, Node *root) : path_(path), root_(root) {}
+
+        iterator begin() const { return {path_, root_}; }
+
+        iterator end() const { return {}; }
+
+    private:
+        const Path *path_;
+        Node *root_;
+    };
+
+    template<class Node>
+    Node *Path::walk(Node &root) const {
+        if (wildcards_) {
+            return *each(root).begin();
+        }
+        auto node = &root;
+        for (auto &&s: segments_) {
+            if (s.kind == Segment::Kind::Key) {
+                node = PathTraits<Node>::key(*node, s.key);
+            } else {
+                auto list = node->List();
+                node = list && s.index < list->size() ? PathTraits<Node>::node((*list)[s.index]) : nullptr;
+            }
+            if (!node) break;
+        }
+        return node;
+    }
+
+    inline BObject *Path::find(BObject &root) const {
+        return walk(root);
+    }
+
+    inline BView *Path::find(BView &root) const {
+        return walk(root);
+    }
+
+    inline Path::Matches<BObject> Path::each(BObject &root) const {
+        return {this, &root};
+    }
+
+    inline Path::Matches<BView> Path::each(BView &root) const {
+        return {this, &root};
+    }
+
+    inline Path::Matches<BView> Path::each(Document &doc) const {
+        return each(doc.root());
+    }
+}
+
+#endif //TEST_BENCODE_PATH_H
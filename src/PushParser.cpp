@@ -0,0 +1,195 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "PushParser.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+void bencode::PushParser::reset() {
+    builder_.root.reset();
+    builder_.depth = 0;
+    builder_.dropped.clear();
+    state_ = State::Value;
+    error_ = Error::NoError;
+    stack_.clear();
+    nodes_ = 0;
+    consumed_ = 0;
+    partial_.clear();
+}
+
+bool bencode::PushParser::endValue() {
+    if (stack_.empty()) {
+        state_ = State::Done;
+        return true;
+    }
+    if (stack_.back() == 'v') {
+        stack_.back() = 'd';
+    }
+    state_ = State::Value;
+    return false;
+}
+
+void bencode::PushParser::endString(std::string_view str) {
+    if (isKey_) {
+        //the value may only arrive with a later chunk,so the key can't stay a view of this one
+        key_.assign(str);
+        builder_.on_key(key_);
+        stack_.back() = 'v';
+        state_ = State::Value;
+        return;
+    }
+    builder_.on_string(str);
+    endValue();
+}
+
+bencode::Feed bencode::PushParser::feed(std::string_view chunk, size_t *used) {
+    auto begin = chunk.data();
+    auto p = begin;
+    auto end = begin + chunk.size();
+    auto finish = [&](Feed ret) {
+        consumed_ += p - begin;
+        if (used)*used = p - begin;
+        return ret;
+    };
+    while (true) {
+        switch (state_) {
+            case State::Done:
+                return finish(Feed::Done);
+            case State::Failed:
+                return finish(Feed::Failed);
+            case State::Value: {
+                if (p == end) {
+                    return finish(Feed::NeedMore);
+                }
+                auto x = *p;
+                if (!stack_.empty()) {
+                    auto top = stack_.back();
+                    if (x == 'e' && top != 'v') {
+                        p++;
+                        stack_.pop_back();
+                        if (top == 'l') builder_.on_list_end();
+                        else builder_.on_dict_end();
+                        endValue();
+                        continue;
+                    }
+                    if (top == 'd') {
+                        isKey_ = true;
+                        length_ = digits_ = 0;
+                        state_ = State::Length;
+                        continue;
+                    }
+                }
+                if (++nodes_ > limits_.max_nodes) {
+                    return finish(fail(Error::ErrCnt));
+                }
+                if (x >= '0' && x <= '9') {
+                    isKey_ = false;
+                    length_ = digits_ = 0;
+                    state_ = State::Length;
+                } else if (x == 'i') {
+                    p++;
+                    neg_ = false;
+                    int_ = 0;
+                    digits_ = 0;
+                    big_ = false;
+                    state_ = State::Int;
+                } else if (x == 'l' || x == 'd') {
+                    if (stack_.size() >= limits_.max_depth) {
+                        return finish(fail(Error::ErrDep));
+                    }
+                    p++;
+                    stack_.push_back(x);
+                    if (x == 'l') builder_.on_list_begin();
+                    else builder_.on_dict_begin();
+                } else {
+                    return finish(fail(Error::ErrIvd));
+                }
+                continue;
+            }
+            case State::Length: {
+                while (p != end && *p >= '0' && *p <= '9') {
+                    if (length_ > (SIZE_MAX - 9) / 10) {
+                        return finish(fail(Error::ErrIvd));
+                    }
+                    length_ = length_ * 10 + (*p - '0');
+                    digits_++;
+                    p++;
+                }
+                if (p == end) {
+                    return finish(Feed::NeedMore);
+                }
+                if (digits_ == 0) {
+                    return finish(fail(Error::ErrNum));
+                }
+                if (*p != ':') {
+                    return finish(fail(Error::ErrCol));
+                }
+                p++;
+                partial_.clear();
+                state_ = State::Body;
+                continue;
+            }
+            case State::Body: {
+                auto avail = size_t(end - p);
+                if (partial_.empty() && avail >= length_) {//the whole string is in this chunk
+                    std::string_view str(p, length_);
+                    p += length_;
+                    endString(str);
+                    continue;
+                }
+                auto take = std::min(avail, length_ - partial_.size());
+                partial_.append(p, take);
+                p += take;
+                if (partial_.size() < length_) {
+                    return finish(Feed::NeedMore);
+                }
+                endString(partial_);
+                continue;
+            }
+            case State::Int: {
+                if (p != end && digits_ == 0 && !neg_ && *p == '-') {
+                    neg_ = true;
+                    p++;
+                }
+                while (p != end && *p >= '0' && *p <= '9') {
+                    //same canonical form as BObject::DecodeInt:no leading zero,no "-0"
+                    if (digits_ == 1 && int_ == 0) {
+                        return finish(fail(Error::ErrNum));
+                    }
+                    if (!big_ && (int_ > (uint64_t(INT64_MAX) + 1) / 10 ||
+                                  int_ * 10 + (*p - '0') > uint64_t(INT64_MAX) + neg_)) {
+                        big_ = true;
+                        partial_.assign(neg_ ? "-" : "");
+                        partial_.append(std::to_string(int_));
+                    }
+                    if (big_) {
+                        partial_.push_back(*p);
+                    } else {
+                        int_ = int_ * 10 + (*p - '0');
+                    }
+                    digits_++;
+                    p++;
+                }
+                if (p == end) {
+                    return finish(Feed::NeedMore);
+                }
+                if (digits_ == 0 || (neg_ && int_ == 0)) {
+                    return finish(fail(Error::ErrNum));
+                }
+                if (*p != 'e') {
+                    return finish(fail(Error::ErrEpE));
+                }
+                p++;
+                if (big_) {
+                    builder_.on_bigint(partial_);
+                } else {
+                    builder_.on_int(neg_ ? int64_t(0 - int_) : int64_t(int_));
+                }
+                endValue();
+                continue;
+            }
+        }
+    }
+}
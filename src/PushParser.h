@@ -0,0 +1,101 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_PUSHPARSER_H
+#define TEST_BENCODE_PUSHPARSER_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bencode {
+    enum class Feed {
+        NeedMore,
+        Done,
+        Failed
+    };
+
+    //resumable parser for a value that arrives in pieces:
+    //  PushParser p;
+    //  while (p.feed(recv()) == Feed::NeedMore) {}
+    //  auto obj = p.take();
+    //every byte is looked at once,only a string or integer cut by a chunk boundary is kept
+    //until the rest of it arrives.an integer outside int64_t becomes a BigInt
+    class PushParser {
+    public:
+        explicit PushParser(const ParseLimits &limits = {}) : limits_(limits) {}
+
+        PushParser(const PushParser &) = delete;
+
+        PushParser &operator=(const PushParser &) = delete;
+
+        //consume the next chunk,on Done *used tells how many bytes of it belonged to the value,
+        //the rest is left to the caller
+        Feed feed(std::string_view chunk, size_t *used = nullptr);
+
+        //the finished value after feed() returned Done
+        std::shared_ptr<BObject> take() {
+            return std::move(builder_.root);
+        }
+
+        Error error() const {
+            return error_;
+        }
+
+        //bytes of the value consumed over all chunks
+        size_t consumed() const {
+            return consumed_;
+        }
+
+        //forget the current value and start over,buffers are kept
+        void reset();
+
+    private:
+        enum class State {
+            Value,//next byte starts a value,a key or a container end
+            Length,//inside the length of a string
+            Body,//inside the bytes of a string
+            Int,//after the 'i' of an integer
+            Done,
+            Failed
+        };
+
+        Feed fail(Error error) {
+            error_ = error;
+            state_ = State::Failed;
+            return Feed::Failed;
+        }
+
+        //a string or integer is complete,returns true once the root value is
+        void endString(std::string_view str);
+
+        bool endValue();
+
+        ParseLimits limits_;
+        BObject::Builder builder_;
+        State state_ = State::Value;
+        Error error_ = Error::NoError;
+        //open containers:'l' list,'d' dict expecting a key,'v' dict expecting a value
+        std::string stack_;
+        size_t nodes_ = 0;
+        size_t consumed_ = 0;
+        //string in progress
+        bool isKey_ = false;
+        size_t length_ = 0;
+        size_t digits_ = 0;
+        std::string partial_;
+        //the pending key,Builder holds a view of it until the value arrives
+        std::string key_;
+        //integer in progress
+        bool neg_ = false;
+        uint64_t int_ = 0;//magnitude
+        bool big_ = false;//outgrew int64_t,the digits are collected in partial_
+    };
+}
+
+#endif //TEST_BENCODE_PUSHPARSER_H
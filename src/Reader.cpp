@@ -0,0 +1,19 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Reader.h"
+#include "BObject.h"
+
+bool bencode::Reader::skip() {
+    if (token_ != Token::ListBegin && token_ != Token::DictBegin) {
+        return error_ == Error::NoError;
+    }
+    auto target = depth_ - 1;
+    while (depth_ > target) {
+        if (!next()) {
+            return false;
+        }
+    }
+    return true;
+}
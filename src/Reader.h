@@ -0,0 +1,248 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_READER_H
+#define TEST_BENCODE_READER_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include <string>
+#include <string_view>
+
+namespace bencode {
+    enum class Token {
+        Int,
+        Str,
+        Key,
+        ListBegin,
+        ListEnd,
+        DictBegin,
+        DictEnd,
+        BigInt//integer outside int64_t,str() holds its digits
+    };
+
+    //pull parser over one bencode value,no tree is built:
+    //  Reader r(msg);
+    //  while (r.next()) { switch (r.token()) {...} }
+    //  if (r.error() != Error::NoError) ...
+    //strings and keys are views into the input buffer
+    class Reader {
+    public:
+        explicit Reader(std::string_view in, const ParseLimits &limits = {})
+                : begin_(in.data()), cur_(in.data()), end_(in.data() + in.size()), limits_(limits) {}
+
+        //advance to the next token,false once the value is complete or on error
+        bool next();
+
+        //after ListBegin/DictBegin consume up to and including the matching end,
+        //strings inside are jumped over by their length prefix
+        bool skip();
+
+        Token token() const {
+            return token_;
+        }
+
+        std::string_view str() const {
+            return str_;
+        }
+
+        int64_t integer() const {
+            return int_;
+        }
+
+        //number of containers currently open
+        size_t depth() const {
+            return depth_;
+        }
+
+        Error error() const {
+            return error_;
+        }
+
+        //bytes used so far,the whole value once next() returned false without error
+        size_t consumed() const {
+            return cur_ - begin_;
+        }
+
+        //push a complete value to a handler with on_int(int64_t),on_string(std::string_view),
+        //on_key(std::string_view),on_list_begin(),on_list_end(),on_dict_begin(),on_dict_end().
+        //integers outside int64_t go to on_bigint(std::string_view digits) if the handler has it,
+        //otherwise they fail with ErrNum
+        template<class Handler>
+        static bool Parse(std::string_view in, Handler &handler, Error *error, size_t *consumed = nullptr,
+                          const ParseLimits &limits = {});
+
+    private:
+        struct TokenSink;
+
+        template<class Sink>
+        bool advance(Sink &sink);
+
+        bool fail(Error error) {
+            error_ = error;
+            return false;
+        }
+
+        char &at(size_t level) {
+            return level < sizeof(small_) ? small_[level] : big_[level - sizeof(small_)];
+        }
+
+        const char *begin_;
+        const char *cur_;
+        const char *end_;
+        ParseLimits limits_;
+        //open containers:'l' list,'d' dict expecting a key,'v' dict expecting a value.
+        //the first 32 levels are kept inline
+        char small_[32];
+        std::string big_;
+        size_t depth_ = 0;
+        size_t nodes_ = 0;
+        bool started_ = false;
+        Error error_ = Error::NoError;
+        Token token_ = Token::Int;
+        std::string_view str_;
+        int64_t int_ = 0;
+    };
+
+    //one step of the state machine,the token goes straight to the sink so Parse()
+    //doesn't decode it twice
+    template<class Sink>
+    bool Reader::advance(Sink &sink) {
+        if (error_ != Error::NoError) {
+            return false;
+        }
+        if (depth_) {
+            auto &top = at(depth_ - 1);
+            if (cur_ == end_) {
+                return fail(Error::ErrEpE);
+            }
+            if (*cur_ == 'e' && top != 'v') {
+                cur_++;
+                depth_--;
+                if (top == 'l') sink.on_list_end();
+                else sink.on_dict_end();
+                return true;
+            }
+            if (top == 'd') {
+                auto key = BObject::DecodeString(cur_, end_, &error_);
+                if (error_ != Error::NoError) {
+                    return false;
+                }
+                top = 'v';
+                sink.on_key(key);
+                return true;
+            }
+        } else if (started_) {//the root value is complete
+            return false;
+        }
+        started_ = true;
+        if (cur_ == end_) {
+            return fail(Error::ErrIvd);
+        }
+        if (++nodes_ > limits_.max_nodes) {
+            return fail(Error::ErrCnt);
+        }
+        if (depth_ && at(depth_ - 1) == 'v') {
+            at(depth_ - 1) = 'd';
+        }
+        auto x = *cur_;
+        if (x >= '0' && x <= '9') {
+            auto str = BObject::DecodeString(cur_, end_, &error_);
+            if (error_ != Error::NoError) {
+                return false;
+            }
+            sink.on_string(str);
+        } else if (x == 'i') {
+            auto val = BObject::DecodeInt(cur_, end_, &error_);
+            if (error_ != Error::NoError) {
+                if constexpr(requires(std::string_view digits) { sink.on_bigint(digits); }) {
+                    if (error_ == Error::ErrNum) {
+                        auto digits = BObject::DecodeIntDigits(cur_, end_, &error_);
+                        if (error_ != Error::NoError) {
+                            return false;
+                        }
+                        sink.on_bigint(digits);
+                        return true;
+                    }
+                }
+                return false;
+            }
+            sink.on_int(val);
+        } else if (x == 'l' || x == 'd') {
+            if (depth_ >= limits_.max_depth) {
+                return fail(Error::ErrDep);
+            }
+            cur_++;
+            if (depth_ >= sizeof(small_)) {
+                big_.resize(depth_ + 1 - sizeof(small_));
+            }
+            at(depth_++) = x;
+            if (x == 'l') sink.on_list_begin();
+            else sink.on_dict_begin();
+        } else {
+            return fail(Error::ErrIvd);
+        }
+        return true;
+    }
+
+    //records the token in the Reader for next()
+    struct Reader::TokenSink {
+        Reader &r;
+
+        void on_int(int64_t val) {
+            r.token_ = Token::Int;
+            r.int_ = val;
+        }
+
+        void on_bigint(std::string_view digits) {
+            r.token_ = Token::BigInt;
+            r.str_ = digits;
+        }
+
+        void on_string(std::string_view str) {
+            r.token_ = Token::Str;
+            r.str_ = str;
+        }
+
+        void on_key(std::string_view key) {
+            r.token_ = Token::Key;
+            r.str_ = key;
+        }
+
+        void on_list_begin() {
+            r.token_ = Token::ListBegin;
+        }
+
+        void on_list_end() {
+            r.token_ = Token::ListEnd;
+        }
+
+        void on_dict_begin() {
+            r.token_ = Token::DictBegin;
+        }
+
+        void on_dict_end() {
+            r.token_ = Token::DictEnd;
+        }
+    };
+
+    inline bool Reader::next() {
+        TokenSink sink{*this};
+        return advance(sink);
+    }
+
+    template<class Handler>
+    bool Reader::Parse(std::string_view in, Handler &handler, Error *error, size_t *consumed,
+                       const ParseLimits &limits) {
+        Reader reader(in, limits);
+        while (reader.advance(handler)) {
+        }
+        if (error)*error = reader.error_;
+        if (consumed)*consumed = reader.error_ == Error::NoError ? reader.consumed() : 0;
+        return reader.error_ == Error::NoError;
+    }
+}
+
+#endif //TEST_BENCODE_READER_H
@@ -0,0 +1,414 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "StructuralIndex.h"
+#include <climits>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BENCODE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+using bencode::StructuralIndex;
+
+namespace {
+    //bit i set <=> byte i of the 64-byte block is that class
+    struct BlockMasks {
+        uint64_t colon;
+        uint64_t e;
+        uint64_t digit;
+    };
+
+    BlockMasks classifyScalar(const char *p) {
+        BlockMasks m{0, 0, 0};
+        for (int i = 0; i < 64; i++) {
+            auto c = p[i];
+            m.colon |= uint64_t(c == ':') << i;
+            m.e |= uint64_t(c == 'e') << i;
+            m.digit |= uint64_t(c >= '0' && c <= '9') << i;
+        }
+        return m;
+    }
+
+#ifdef BENCODE_X86_SIMD
+    __attribute__((target("sse4.2")))
+    BlockMasks classifySse42(const char *p) {
+        const auto colon = _mm_set1_epi8(':');
+        const auto e = _mm_set1_epi8('e');
+        const auto zero = _mm_set1_epi8('0');
+        const auto nine = _mm_set1_epi8(9);
+        BlockMasks m{0, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * 16));
+            auto d = _mm_sub_epi8(x, zero);
+            m.colon |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(x, colon)))) << (i * 16);
+            m.e |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(x, e)))) << (i * 16);
+            m.digit |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, nine), d)))) << (i * 16);
+        }
+        return m;
+    }
+
+    __attribute__((target("avx2")))
+    BlockMasks classifyAvx2(const char *p) {
+        const auto colon = _mm256_set1_epi8(':');
+        const auto e = _mm256_set1_epi8('e');
+        const auto zero = _mm256_set1_epi8('0');
+        const auto nine = _mm256_set1_epi8(9);
+        BlockMasks m{0, 0, 0};
+        for (int i = 0; i < 2; i++) {
+            auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 32));
+            auto d = _mm256_sub_epi8(x, zero);
+            m.colon |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, colon)))) << (i * 32);
+            m.e |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, e)))) << (i * 32);
+            m.digit |= uint64_t(uint32_t(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d)))) << (i * 32);
+        }
+        return m;
+    }
+#endif
+
+    using ClassifyFn = BlockMasks (*)(const char *);
+
+    struct Classifier {
+        ClassifyFn fn;
+        const char *name;
+    };
+
+    Classifier pickClassifier() {
+#ifdef BENCODE_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {classifyAvx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return {classifySse42, "sse4.2"};
+        }
+#endif
+        return {classifyScalar, "scalar"};
+    }
+
+    const Classifier classifier = pickClassifier();
+
+    //classifies blocks on demand and remembers the last one,so blocks inside skipped
+    //string bodies are never touched
+    class BlockScanner {
+    public:
+        explicit BlockScanner(std::string_view in) : in_(in) {}
+
+        const BlockMasks &masks(size_t block) {
+            if (block != block_) {
+                block_ = block;
+                auto off = block * 64;
+                if (off + 64 <= in_.size()) {
+                    masks_ = classifier.fn(in_.data() + off);
+                } else {//tail,pad with bytes of no class
+                    char pad[64] = {};
+                    std::memcpy(pad, in_.data() + off, in_.size() - off);
+                    masks_ = classifier.fn(pad);
+                }
+            }
+            return masks_;
+        }
+
+        //first position >= from whose byte is in the class,in_.size() if there is none
+        template<uint64_t BlockMasks::*Class>
+        size_t findNext(size_t from) {
+            auto block = from / 64;
+            auto bits = masks(block).*Class & (~uint64_t(0) << (from % 64));
+            while (!bits) {
+                block++;
+                if (block * 64 >= in_.size()) {
+                    return in_.size();
+                }
+                bits = masks(block).*Class;
+            }
+            return block * 64 + __builtin_ctzll(bits);
+        }
+
+        //true if every byte in [from,to) is a digit
+        bool allDigits(size_t from, size_t to) {
+            while (from < to) {
+                auto block = from / 64;
+                auto hi = std::min(to, block * 64 + 64);
+                auto width = hi - from;
+                auto want = (width == 64 ? ~uint64_t(0) : ((uint64_t(1) << width) - 1)) << (from % 64);
+                if ((masks(block).digit & want) != want) {
+                    return false;
+                }
+                from = hi;
+            }
+            return true;
+        }
+
+    private:
+        std::string_view in_;
+        size_t block_ = SIZE_MAX;
+        BlockMasks masks_{};
+    };
+}
+
+const char *bencode::StructuralIndex::Implementation() {
+    return classifier.name;
+}
+
+StructuralIndex bencode::StructuralIndex::Build(std::string_view in, Error *error, size_t *consumed,
+                                                const ParseLimits &limits) {
+    StructuralIndex index;
+    BlockScanner scanner(in);
+    //open containers,'d' means the next token of that dict is a key
+    std::vector<char> stack;
+    auto n = in.size();
+    size_t pos = 0, nodes = 0;
+    Error err = Error::NoError;
+    auto fail = [&](Error e) {
+        err = e;
+    };
+    while (err == Error::NoError) {
+        if (pos >= n) {
+            fail(stack.empty() ? Error::ErrIvd : Error::ErrEpE);
+            break;
+        }
+        auto c = in[pos];
+        bool keyExpected = !stack.empty() && stack.back() == 'd';
+        if (!keyExpected && !(c == 'e' && !stack.empty()) && ++nodes > limits.max_nodes) {
+            fail(Error::ErrCnt);
+            break;
+        }
+        if (c == 'e' && !stack.empty()) {
+            if (stack.back() == 'v') {//a dict key without its value
+                fail(Error::ErrIvd);
+                break;
+            }
+            index.positions_.push_back(pos++);
+            stack.pop_back();
+        } else if (keyExpected && !(c >= '0' && c <= '9')) {
+            fail(Error::ErrNum);
+            break;
+        } else if (c == 'd' || c == 'l') {
+            if (stack.size() >= limits.max_depth) {
+                fail(Error::ErrDep);
+                break;
+            }
+            index.positions_.push_back(pos++);
+            if (!stack.empty() && stack.back() == 'v') {
+                stack.back() = 'd';
+            }
+            stack.push_back(c);
+            continue;
+        } else if (c == 'i') {
+            auto end = scanner.findNext<&BlockMasks::e>(pos + 1);
+            if (end == n) {
+                fail(Error::ErrEpE);
+                break;
+            }
+            bool neg = in[pos + 1] == '-';
+            auto digits = pos + 1 + neg;
+            if (digits == end || !scanner.allDigits(digits, end)) {
+                fail(Error::ErrNum);
+                break;
+            }
+            if (in[digits] == '0' && (end - digits > 1 || neg)) {//leading zero or "-0",at any length
+                fail(Error::ErrNum);
+                break;
+            }
+            if (end - digits >= 10) {//might not fit,let the real decoder judge
+                auto cur = in.data() + pos;
+                BObject::DecodeInt(cur, in.data() + n, &err);
+                if (err == Error::ErrNum) {//too big for int64_t is still a valid BigInt
+                    BObject::DecodeIntDigits(cur, in.data() + n, &err);
+                }
+                if (err != Error::NoError) {
+                    break;
+                }
+            }
+            index.positions_.push_back(pos);
+            pos = end + 1;
+        } else if (c >= '0' && c <= '9') {
+            auto colon = scanner.findNext<&BlockMasks::colon>(pos);
+            if (colon == n || !scanner.allDigits(pos, colon)) {
+                fail(Error::ErrCol);
+                break;
+            }
+            size_t len = 0;
+            for (auto p = pos; p < colon; p++) {
+                len = len * 10 + (in[p] - '0');
+                if (len > n) {
+                    break;
+                }
+            }
+            if (len > n - colon - 1) {
+                fail(Error::ErrIvd);
+                break;
+            }
+            index.positions_.push_back(pos);
+            pos = colon + 1 + len;
+            if (keyExpected) {
+                stack.back() = 'v';
+                continue;
+            }
+        } else {
+            fail(Error::ErrIvd);
+            break;
+        }
+        //a complete value was consumed
+        if (stack.empty()) {
+            break;
+        }
+        if (stack.back() == 'v') {
+            stack.back() = 'd';
+        }
+    }
+    if (error)*error = err;
+    if (err != Error::NoError) {
+        if (consumed)*consumed = 0;
+        return {};
+    }
+    if (consumed)*consumed = pos;
+    index.in_ = in.substr(0, pos);
+    return index;
+}
+
+//stage 2,stage 1 already checked the tokens.a decoder failing here means the two disagree,
+//so it is reported instead of building a wrong value
+std::shared_ptr<bencode::BObject> bencode::StructuralIndex::ToObject(Error *error) const {
+    struct Frame {
+        bool dict;
+        BObject::LIST list;
+        BObject::DICT dict_value;
+        __KEY__ key;
+        bool has_key;
+    };
+    if (positions_.empty()) {
+        if (error)*error = Error::ErrIvd;
+        return nullptr;
+    }
+    std::vector<Frame> stack;
+    std::shared_ptr<BObject> root;
+    auto base = in_.data();
+    auto end = base + in_.size();
+    Error err = Error::NoError;
+    for (auto pos: positions_) {
+        auto cur = base + pos;
+        std::shared_ptr<BObject> value;
+        switch (*cur) {
+            case 'd':
+            case 'l':
+                stack.push_back({*cur == 'd', {}, {}, {}, false});
+                continue;
+            case 'e': {
+                auto &top = stack.back();
+                value = top.dict ? std::make_shared<BObject>(std::move(top.dict_value))
+                                 : std::make_shared<BObject>(std::move(top.list));
+                stack.pop_back();
+                break;
+            }
+            case 'i': {
+                auto val = BObject::DecodeInt(cur, end, &err);
+                if (err == Error::ErrNum) {
+                    auto digits = BObject::DecodeIntDigits(cur, end, &err);
+                    if (err == Error::NoError) {
+                        value = std::make_shared<BObject>(BigInt::Parse(digits, &err));
+                    }
+                } else {
+                    value = std::make_shared<BObject>(val);
+                }
+                if (err != Error::NoError) {
+                    if (error)*error = err;
+                    return nullptr;
+                }
+                break;
+            }
+            default: {
+                auto str = BObject::DecodeString(cur, end, &err);
+                if (err != Error::NoError) {
+                    if (error)*error = err;
+                    return nullptr;
+                }
+                if (!stack.empty() && stack.back().dict && !stack.back().has_key) {
+                    stack.back().key = InputKey(str);
+                    stack.back().has_key = true;
+                    continue;
+                }
+                value = std::make_shared<BObject>(std::string(str));
+                break;
+            }
+        }
+        if (stack.empty()) {
+            root = std::move(value);
+        } else if (stack.back().dict) {
+            stack.back().dict_value.emplace(std::move(stack.back().key), std::move(value));
+            stack.back().has_key = false;
+        } else {
+            stack.back().list.push_back(std::move(value));
+        }
+    }
+    if (error)*error = Error::NoError;
+    return root;
+}
+
+bencode::Tape bencode::StructuralIndex::ToTape(Error *error) const {
+    struct Frame {
+        size_t start;
+        size_t count;
+        bool dict;
+    };
+    if (positions_.empty()) {
+        if (error)*error = Error::ErrIvd;
+        return {};
+    }
+    Tape tape;
+    tape.tape_.reserve(positions_.size() * 2);
+    std::vector<Frame> stack;
+    auto base = in_.data();
+    auto end = base + in_.size();
+    Error err = Error::NoError;
+    for (auto pos: positions_) {
+        auto cur = base + pos;
+        switch (*cur) {
+            case 'd':
+            case 'l':
+                if (!stack.empty()) stack.back().count++;
+                stack.push_back({tape.openContainer(*cur), 0, *cur == 'd'});
+                break;
+            case 'e':
+                //dict children were counted per key and per value
+                if (!tape.closeContainer(stack.back().start,
+                                         stack.back().dict ? stack.back().count / 2 : stack.back().count)) {
+                    if (error)*error = Error::ErrCnt;
+                    return {};
+                }
+                stack.pop_back();
+                break;
+            case 'i':
+                if (!stack.empty()) stack.back().count++;
+            {
+                auto val = BObject::DecodeInt(cur, end, &err);
+                if (err == Error::ErrNum) {
+                    auto digits = BObject::DecodeIntDigits(cur, end, &err);
+                    if (err == Error::NoError) {
+                        tape.appendBigInt(digits);
+                    }
+                } else if (err == Error::NoError) {
+                    tape.appendInt(val);
+                }
+                break;
+            }
+            default: {
+                if (!stack.empty()) stack.back().count++;
+                auto str = BObject::DecodeString(cur, end, &err);
+                if (err == Error::NoError) {
+                    tape.appendString(str);
+                }
+                break;
+            }
+        }
+        if (err != Error::NoError) {
+            if (error)*error = err;
+            return {};
+        }
+    }
+    if (error)*error = Error::NoError;
+    return tape;
+}
@@ -0,0 +1,52 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_STRUCTURALINDEX_H
+#define TEST_BENCODE_STRUCTURALINDEX_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include "Tape.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace bencode {
+    //stage 1:offsets of every token ('d','l','e','i' and string length prefixes) of one value.
+    //64-byte blocks are classified with SIMD (AVX2/SSE4.2,scalar fallback,picked at runtime);
+    //string bodies are skipped by their length prefix and never classified.
+    //stage 2 walks the index to build a BObject tree or a Tape,the grammar is already checked.
+    //offsets are 64-bit,so an input past 4 GiB is indexed like any other
+    class StructuralIndex {
+    public:
+        StructuralIndex() = default;
+
+        static StructuralIndex Build(std::string_view in, Error *error, size_t *consumed = nullptr,
+                                     const ParseLimits &limits = {});
+
+        //stage 2
+        std::shared_ptr<BObject> ToObject(Error *error = nullptr) const;
+
+        Tape ToTape(Error *error = nullptr) const;
+
+        const std::vector<uint64_t> &positions() const {
+            return positions_;
+        }
+
+        std::string_view input() const {
+            return in_;
+        }
+
+        //"avx2","sse4.2" or "scalar"
+        static const char *Implementation();
+
+    private:
+        std::string_view in_;
+        std::vector<uint64_t> positions_;
+    };
+}
+
+#endif //TEST_BENCODE_STRUCTURALINDEX_H
@@ -0,0 +1,103 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Symbol.h"
+#include <algorithm>
+
+using bencode::Symbol;
+using bencode::SymbolEntry;
+using bencode::SymbolTable;
+
+namespace {
+    //interned,so it is never counted or freed
+    const SymbolEntry EmptyEntry{{}, std::hash<std::string_view>()({}), true, {0}};
+    constexpr size_t InitialSlots = 256;
+}
+
+const SymbolEntry *bencode::Symbol::emptyEntry() noexcept {
+    return &EmptyEntry;
+}
+
+bencode::Symbol::Symbol(std::string_view text) : Symbol(text, SymbolTable::MaxSymbols) {
+
+}
+
+bencode::Symbol::Symbol(std::string_view text, size_t limit) {
+    if (text.empty()) {
+        entry_ = &EmptyEntry;
+        return;
+    }
+    auto hash = std::hash<std::string_view>()(text);
+    auto &table = SymbolTable::global();
+    entry_ = table.find(text, hash);
+    if (!entry_) entry_ = table.intern(text, hash, limit);
+    if (!entry_) entry_ = new SymbolEntry{std::string(text), hash, false, {1}};
+}
+
+SymbolTable &bencode::SymbolTable::global() {
+    //never destroyed,symbols in static objects may still point into it at exit
+    static auto table = new SymbolTable();
+    return *table;
+}
+
+bencode::SymbolTable::SymbolTable() {
+    auto slots = std::make_unique<Slots>(Slots{InitialSlots - 1,
+                                               std::make_unique<std::atomic<const SymbolEntry *>[]>(InitialSlots)});
+    table_.store(slots.get(), std::memory_order_release);
+    tables_.push_back(std::move(slots));
+}
+
+const SymbolEntry *bencode::SymbolTable::probe(const Slots &table, std::string_view text, size_t hash) {
+    for (auto i = hash & table.mask;; i = (i + 1) & table.mask) {
+        auto entry = table.slots[i].load(std::memory_order_acquire);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->hash == hash && entry->text == text) {
+            return entry;
+        }
+    }
+}
+
+const SymbolEntry *bencode::SymbolTable::find(std::string_view text, size_t hash) const {
+    return probe(*table_.load(std::memory_order_acquire), text, hash);
+}
+
+const SymbolEntry *bencode::SymbolTable::intern(std::string_view text, size_t hash, size_t limit) {
+    if (text.size() > MaxLength) {
+        return nullptr;
+    }
+    std::lock_guard lock(mutex_);
+    auto table = table_.load(std::memory_order_relaxed);
+    //another thread may have added it since the lock-free lookup
+    if (auto entry = probe(*table, text, hash)) {
+        return entry;
+    }
+    auto count = count_.load(std::memory_order_relaxed);
+    if (count >= std::min(limit, MaxSymbols)) {
+        return nullptr;
+    }
+    //keep the load at most one half so probe chains stay short
+    if ((count + 1) * 2 > table->mask + 1) {
+        auto size = (table->mask + 1) * 2;
+        auto grown = std::make_unique<Slots>(Slots{size - 1,
+                                                   std::make_unique<std::atomic<const SymbolEntry *>[]>(size)});
+        for (size_t i = 0; i <= table->mask; i++) {
+            if (auto entry = table->slots[i].load(std::memory_order_relaxed)) {
+                auto j = entry->hash & grown->mask;
+                while (grown->slots[j].load(std::memory_order_relaxed)) j = (j + 1) & grown->mask;
+                grown->slots[j].store(entry, std::memory_order_relaxed);
+            }
+        }
+        table = grown.get();
+        tables_.push_back(std::move(grown));
+        table_.store(table, std::memory_order_release);
+    }
+    auto &entry = entries_.emplace_back(std::string(text), hash, true, 0);
+    auto i = hash & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed)) i = (i + 1) & table->mask;
+    table->slots[i].store(&entry, std::memory_order_release);
+    count_.store(count + 1, std::memory_order_relaxed);
+    return &entry;
+}
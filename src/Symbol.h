@@ -0,0 +1,175 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_SYMBOL_H
+#define TEST_BENCODE_SYMBOL_H
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace bencode {
+    struct SymbolEntry {
+        std::string text;
+        size_t hash;
+        bool interned;
+        mutable std::atomic<uint32_t> refs;//only used when not interned
+    };
+
+    //process wide set of interned keys.lookups never lock:the slot array is only ever filled in,
+    //a grown array is published with one atomic store and the old one is kept for readers still
+    //probing it.inserts take a mutex.keys are never removed,so the table is bounded by MaxSymbols
+    //and MaxLength,and keys read from parsed input may only take MaxInputSymbols of it:hostile
+    //input can't use up the room left for the keys a program names itself
+    class SymbolTable {
+    public:
+        static constexpr size_t MaxSymbols = 1 << 16;
+        static constexpr size_t MaxInputSymbols = MaxSymbols / 2;
+        static constexpr size_t MaxLength = 64;
+
+        static SymbolTable &global();
+
+        //nullptr if text isn't interned
+        const SymbolEntry *find(std::string_view text, size_t hash) const;
+
+        //the entry for text,added if needed while the table holds fewer than limit keys.
+        //nullptr when text can't be interned
+        const SymbolEntry *intern(std::string_view text, size_t hash, size_t limit = MaxSymbols);
+
+        size_t size() const {
+            return count_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Slots {
+            size_t mask;
+            std::unique_ptr<std::atomic<const SymbolEntry *>[]> slots;
+        };
+
+        SymbolTable();
+
+        static const SymbolEntry *probe(const Slots &table, std::string_view text, size_t hash);
+
+        std::atomic<const Slots *> table_;
+        std::atomic<size_t> count_{0};
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<Slots>> tables_;
+        std::deque<SymbolEntry> entries_;
+    };
+
+    //interned dict key,selected as the DICT key type by I_KEY:equal keys share one entry,so
+    //equality is a pointer compare and a key costs 8 bytes in a node.a key the table can't take
+    //gets a private reference counted entry and is compared by its text
+    class Symbol {
+    public:
+        Symbol() noexcept : entry_(emptyEntry()) {}
+
+        Symbol(std::string_view text);
+
+        Symbol(const std::string &text) : Symbol(std::string_view(text)) {}
+
+        Symbol(const char *text) : Symbol(std::string_view(text)) {}
+
+        //a key read from parsed input,interned only within SymbolTable::MaxInputSymbols
+        static Symbol FromInput(std::string_view text) {
+            return Symbol(text, SymbolTable::MaxInputSymbols);
+        }
+
+        Symbol(const Symbol &o) noexcept : entry_(o.entry_) {
+            retain();
+        }
+
+        Symbol(Symbol &&o) noexcept : entry_(o.entry_) {
+            o.entry_ = emptyEntry();
+        }
+
+        ~Symbol() {
+            release();
+        }
+
+        Symbol &operator=(Symbol o) noexcept {
+            std::swap(entry_, o.entry_);
+            return *this;
+        }
+
+        const std::string &str() const { return entry_->text; }
+
+        std::string_view view() const { return entry_->text; }
+
+        operator std::string_view() const { return entry_->text; }
+
+        operator const std::string &() const { return entry_->text; }
+
+        const char *data() const { return entry_->text.data(); }
+
+        const char *c_str() const { return entry_->text.c_str(); }
+
+        size_t size() const { return entry_->text.size(); }
+
+        bool empty() const { return entry_->text.empty(); }
+
+        size_t hash() const { return entry_->hash; }
+
+        bool interned() const { return entry_->interned; }
+
+        //interned entries are unique per text,so different pointers only need a text compare
+        //when neither is interned
+        friend bool operator==(const Symbol &a, const Symbol &b) {
+            return a.entry_ == b.entry_ || (!a.entry_->interned && !b.entry_->interned && a.entry_->text == b.entry_->text);
+        }
+
+        friend std::strong_ordering operator<=>(const Symbol &a, const Symbol &b) {
+            if (a.entry_ == b.entry_) return std::strong_ordering::equal;
+            return a.view() <=> b.view();
+        }
+
+        //against plain text,without interning it
+        template<class T>
+        requires (std::is_convertible_v<const T &, std::string_view> && !std::is_same_v<T, Symbol>)
+        friend bool operator==(const Symbol &a, const T &b) {
+            return a.view() == std::string_view(b);
+        }
+
+        template<class T>
+        requires (std::is_convertible_v<const T &, std::string_view> && !std::is_same_v<T, Symbol>)
+        friend std::strong_ordering operator<=>(const Symbol &a, const T &b) {
+            return a.view() <=> std::string_view(b);
+        }
+
+    private:
+        Symbol(std::string_view text, size_t limit);
+
+        static const SymbolEntry *emptyEntry() noexcept;
+
+        void retain() const {
+            if (!entry_->interned) entry_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() {
+            if (!entry_->interned && entry_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete entry_;
+            }
+        }
+
+        const SymbolEntry *entry_;
+    };
+}
+
+template<>
+struct std::hash<bencode::Symbol> {
+    size_t operator()(const bencode::Symbol &s) const noexcept {
+        return s.hash();
+    }
+};
+
+#endif //TEST_BENCODE_SYMBOL_H
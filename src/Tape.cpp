@@ -0,0 +1,438 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Tape.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+using bencode::Tape;
+using bencode::TapeRef;
+using bencode::TapeList;
+using bencode::TapeDict;
+
+static constexpr uint64_t EndMask = Tape::MaxWords;
+static constexpr uint64_t CountMax = 0xFFFFFF;
+
+static char tagOfWord(uint64_t word) {
+    return char(word >> 56);
+}
+
+uint64_t bencode::TapeRef::word() const {
+    return tape_->tape_[index_];
+}
+
+bencode::BType bencode::TapeRef::type() const {
+    switch (tagOfWord(word())) {
+        case 's':
+            return BType::BSTR;
+        case 'i':
+        case 'n':
+            return BType::BINT;
+        case 'l':
+            return BType::BLIST;
+        default:
+            return BType::BDICT;
+    }
+}
+
+size_t bencode::TapeRef::next() const {
+    auto w = word();
+    switch (tagOfWord(w)) {
+        case 'l':
+        case 'd':
+            return w & EndMask;
+        default:
+            return index_ + 2;
+    }
+}
+
+std::string_view bencode::TapeRef::Str(Error *error_code) const {
+    auto w = word();
+    if (tagOfWord(w) != 's') {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    return {tape_->strings_.data() + (w & Tape::PayloadMask), size_t(tape_->tape_[index_ + 1])};
+}
+
+int64_t bencode::TapeRef::Int(Error *error_code) const {
+    auto tag = tagOfWord(word());
+    if (tag != 'i') {
+        if (error_code)*error_code = tag == 'n' ? Error::ErrNum : Error::ErrTyp;
+        return 0;
+    }
+    if (error_code)*error_code = Error::NoError;
+    return int64_t(tape_->tape_[index_ + 1]);
+}
+
+std::string bencode::TapeRef::raw_digits(Error *error_code) const {
+    auto w = word();
+    switch (tagOfWord(w)) {
+        case 'i':
+            if (error_code)*error_code = Error::NoError;
+            return std::to_string(Int());
+        case 'n':
+            if (error_code)*error_code = Error::NoError;
+            return {tape_->strings_.data() + (w & Tape::PayloadMask), size_t(tape_->tape_[index_ + 1])};
+        default:
+            if (error_code)*error_code = Error::ErrTyp;
+            return {};
+    }
+}
+
+bencode::BigInt bencode::TapeRef::as_bigint(Error *error_code) const {
+    auto tag = tagOfWord(word());
+    if (tag == 'i') {
+        if (error_code)*error_code = Error::NoError;
+        return BigInt(Int());
+    }
+    if (tag != 'n') {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    return BigInt::Parse(raw_digits(), error_code);
+}
+
+//child count is kept in 24 bits,bigger containers are counted by walking them
+template<class Range>
+static size_t countChildren(uint64_t word, const Range &range) {
+    auto count = (word >> 32) & CountMax;
+    if (count < CountMax) {
+        return count;
+    }
+    count = 0;
+    for (auto it = range.begin(); it != range.end(); ++it) {
+        count++;
+    }
+    return count;
+}
+
+TapeList bencode::TapeRef::List(Error *error_code) const {
+    auto w = word();
+    if (tagOfWord(w) != 'l') {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    TapeList list(tape_, index_ + 1, (w & EndMask) - 1, 0);
+    return {tape_, index_ + 1, (w & EndMask) - 1, countChildren(w, list)};
+}
+
+TapeDict bencode::TapeRef::Dict(Error *error_code) const {
+    auto w = word();
+    if (tagOfWord(w) != 'd') {
+        if (error_code)*error_code = Error::ErrTyp;
+        return {};
+    }
+    if (error_code)*error_code = Error::NoError;
+    TapeDict dict(tape_, index_ + 1, (w & EndMask) - 1, 0);
+    return {tape_, index_ + 1, (w & EndMask) - 1, countChildren(w, dict)};
+}
+
+//linear walk over the tape,no recursion needed since 'e' entries are on the tape too
+int bencode::TapeRef::Bencode(std::ostream &os) const {
+    int wLen = 0;
+    if (!os) {
+        return wLen;
+    }
+    auto &tape = tape_->tape_;
+    for (size_t i = index_, last = next(); i < last;) {
+        TapeRef ref(tape_, i);
+        switch (tagOfWord(tape[i])) {
+            case 's':
+                wLen += BObject::EncodeString(os, ref.Str());
+                i += 2;
+                break;
+            case 'i':
+                wLen += BObject::EncodeInt(os, ref.Int());
+                i += 2;
+                break;
+            case 'n':
+                wLen += BObject::EncodeIntDigits(os, ref.raw_digits());
+                i += 2;
+                break;
+            default://'l','d','e'
+                os << tagOfWord(tape[i]);
+                wLen++;
+                i++;
+                break;
+        }
+    }
+    return wLen;
+}
+
+//linear walk like Bencode,finished children wait on one value stack until their container's
+//'e' entry moves them in.dict keys are collected separately since they are plain strings
+std::shared_ptr<bencode::BObject> bencode::TapeRef::to_object() const {
+    struct Frame {
+        size_t start;
+        size_t keys;
+        bool dict;
+        bool key;//the next dict child is a key
+    };
+    std::vector<Frame> stack;
+    std::vector<std::shared_ptr<BObject>> done;
+    std::vector<std::string_view> keys;
+    auto &tape = tape_->tape_;
+    for (size_t i = index_, last = next(); i < last;) {
+        TapeRef ref(tape_, i);
+        auto tag = tagOfWord(tape[i]);
+        if (tag == 's' && !stack.empty() && stack.back().key) {
+            keys.push_back(ref.Str());
+            stack.back().key = false;
+            i += 2;
+            continue;
+        }
+        std::shared_ptr<BObject> value;
+        switch (tag) {
+            case 's':
+                value = std::make_shared<BObject>(std::string(ref.Str()));
+                i += 2;
+                break;
+            case 'i':
+                value = std::make_shared<BObject>(ref.Int());
+                i += 2;
+                break;
+            case 'n':
+                value = std::make_shared<BObject>(ref.as_bigint());
+                i += 2;
+                break;
+            case 'l':
+            case 'd':
+                stack.push_back({done.size(), keys.size(), tag == 'd', tag == 'd'});
+                i++;
+                continue;
+            default: {//'e'
+                auto top = stack.back();
+                stack.pop_back();
+                if (top.dict) {
+                    BObject::DICT dict;
+                    for (size_t k = 0; top.start + k < done.size(); k++) {
+                        dict.emplace(InputKey(keys[top.keys + k]), std::move(done[top.start + k]));
+                    }
+                    keys.resize(top.keys);
+                    value = std::make_shared<BObject>(std::move(dict));
+                } else {
+                    BObject::LIST list(std::make_move_iterator(done.begin() + top.start),
+                                       std::make_move_iterator(done.end()));
+                    value = std::make_shared<BObject>(std::move(list));
+                }
+                done.resize(top.start);
+                i++;
+                break;
+            }
+        }
+        if (!stack.empty() && stack.back().dict) {
+            stack.back().key = true;
+        }
+        done.push_back(std::move(value));
+    }
+    return done.empty() ? nullptr : std::move(done.back());
+}
+
+TapeRef bencode::TapeList::at(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("TapeList at() out of range");
+    }
+    auto it = begin();
+    while (index--) {
+        ++it;
+    }
+    return *it;
+}
+
+TapeDict::iterator bencode::TapeDict::find(std::string_view key) const {
+    for (auto it = begin(); it != end(); ++it) {
+        if ((*it).first == key) {
+            return it;
+        }
+    }
+    return end();
+}
+
+void bencode::Tape::appendString(std::string_view str) {
+    tape_.push_back(tagOf('s') | strings_.size());
+    tape_.push_back(str.size());
+    strings_.append(str);
+}
+
+void bencode::Tape::appendInt(int64_t val) {
+    tape_.push_back(tagOf('i'));
+    tape_.push_back(uint64_t(val));
+}
+
+void bencode::Tape::appendBigInt(std::string_view digits) {
+    tape_.push_back(tagOf('n') | strings_.size());
+    tape_.push_back(digits.size());
+    strings_.append(digits);
+}
+
+size_t bencode::Tape::openContainer(char tag) {
+    tape_.push_back(tagOf(tag));
+    return tape_.size() - 1;
+}
+
+bool bencode::Tape::closeContainer(size_t start, size_t count) {
+    tape_.push_back(tagOf('e') | start);
+    if (tape_.size() > MaxWords) {
+        return false;
+    }
+    tape_[start] |= (std::min<uint64_t>(count, CountMax) << 32) | tape_.size();
+    return true;
+}
+
+//iterative:open containers are kept on a small frame stack,the tape is written front to back
+Tape bencode::Tape::Parse(std::string_view in, Error *error, size_t *consumed, const ParseLimits &limits) {
+    struct Frame {
+        size_t start;
+        size_t count;
+        bool dict;
+    };
+    Tape tape;
+    std::vector<Frame> stack;
+    Error err = Error::NoError;
+    auto cur = in.data();
+    auto end = in.data() + in.size();
+    size_t nodes = 0;
+    do {
+        if (!stack.empty()) {
+            auto &top = stack.back();
+            if (cur == end) {
+                err = Error::ErrEpE;
+                break;
+            }
+            if (*cur == 'e') {
+                cur++;
+                if (!tape.closeContainer(top.start, top.count)) {
+                    err = Error::ErrCnt;
+                    break;
+                }
+                stack.pop_back();
+                continue;
+            }
+            if (top.dict) {
+                auto key = BObject::DecodeString(cur, end, &err);
+                if (err != Error::NoError) {
+                    break;
+                }
+                tape.appendString(key);
+            }
+            top.count++;
+        }
+        if (cur == end) {
+            err = Error::ErrIvd;
+            break;
+        }
+        if (++nodes > limits.max_nodes) {
+            err = Error::ErrCnt;
+            break;
+        }
+        auto x = *cur;
+        if (x >= '0' && x <= '9') {
+            auto str = BObject::DecodeString(cur, end, &err);
+            if (err != Error::NoError) {
+                break;
+            }
+            tape.appendString(str);
+        } else if (x == 'i') {
+            auto val = BObject::DecodeInt(cur, end, &err);
+            if (err == Error::ErrNum) {
+                auto digits = BObject::DecodeIntDigits(cur, end, &err);
+                if (err != Error::NoError) {
+                    break;
+                }
+                tape.appendBigInt(digits);
+                continue;
+            }
+            if (err != Error::NoError) {
+                break;
+            }
+            tape.appendInt(val);
+        } else if (x == 'l' || x == 'd') {
+            if (stack.size() >= limits.max_depth) {
+                err = Error::ErrDep;
+                break;
+            }
+            cur++;
+            stack.push_back({tape.openContainer(x), 0, x == 'd'});
+        } else {
+            err = Error::ErrIvd;
+            break;
+        }
+    } while (!stack.empty());
+
+    if (error)*error = err;
+    if (err != Error::NoError) {
+        if (consumed)*consumed = 0;
+        return {};
+    }
+    if (consumed)*consumed = cur - in.data();
+    return tape;
+}
+
+//iterative,open containers are frames on a small stack like BObject's own encoder
+bool bencode::Tape::appendObject(BObject &object) {
+    struct Frame {
+        BObject *obj;
+        size_t start;
+        size_t index;
+        BObject::DICT::iterator it;
+    };
+    std::vector<Frame> stack;
+    BObject *cur = &object;
+    while (true) {
+        if (cur) {
+            if (auto str = cur->Str()) {
+                appendString(*str);
+            } else if (auto val = cur->Int()) {
+                appendInt(*val);
+            } else if (auto digits = cur->raw_digits(); !digits.empty()) {
+                appendBigInt(digits);
+            } else if (cur->List()) {
+                stack.push_back({cur, openContainer('l'), 0, {}});
+            } else if (auto dict = cur->Dict()) {
+                stack.push_back({cur, openContainer('d'), 0, dict->begin()});
+            }
+            cur = nullptr;
+        }
+        if (stack.empty()) {
+            break;
+        }
+        auto &top = stack.back();
+        size_t count;
+        if (auto list = top.obj->List()) {
+            if (top.index < list->size()) {
+                cur = (*list)[top.index++].get();
+                continue;
+            }
+            count = list->size();
+        } else {
+            auto dict = top.obj->Dict();
+            if (top.it != dict->end()) {
+                appendString(top.it->first);
+                cur = top.it->second.get();
+                ++top.it;
+                continue;
+            }
+            count = dict->size();
+        }
+        if (!closeContainer(top.start, count)) {
+            return false;
+        }
+        stack.pop_back();
+    }
+    return true;
+}
+
+Tape bencode::Tape::From(BObject &object, Error *error) {
+    Tape tape;
+    if (!tape.appendObject(object)) {
+        if (error)*error = Error::ErrCnt;
+        return {};
+    }
+    if (error)*error = Error::NoError;
+    return tape;
+}
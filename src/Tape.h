@@ -0,0 +1,299 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_TAPE_H
+#define TEST_BENCODE_TAPE_H
+
+#include "config.h"
+#include "type.h"
+#include "BObject.h"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bencode {
+    class Tape;
+
+    class TapeList;
+
+    class TapeDict;
+
+    //tape layout,every entry is one uint64_t with the tag in the top byte:
+    //  'i' | 0            , next word is the value
+    //  'n' | arena offset , next word is the length,digits of an integer outside int64_t
+    //  's' | arena offset , next word is the length
+    //  'l'/'d' | (child count << 32) | index one past the matching 'e'
+    //  'e' | index of the matching 'l'/'d'
+    //dict children alternate key and value,the key is always an 's' entry
+    class TapeRef {
+    public:
+        TapeRef() = default;
+
+        TapeRef(const Tape *tape, size_t index) : tape_(tape), index_(index) {}
+
+        BType type() const;
+
+        std::string_view Str(Error *error_code = nullptr) const;
+
+        //ErrNum if the integer doesn't fit int64_t,see as_bigint()
+        int64_t Int(Error *error_code = nullptr) const;
+
+        //checked integer conversion,ErrTyp for a non integer,ErrNum when the value doesn't fit T
+        template<class T>
+        T as(Error *error_code = nullptr) const;
+
+        BigInt as_bigint(Error *error_code = nullptr) const;
+
+        std::string raw_digits(Error *error_code = nullptr) const;
+
+        TapeList List(Error *error_code = nullptr) const;
+
+        TapeDict Dict(Error *error_code = nullptr) const;
+
+        //index of the entry after this value,containers are skipped in one jump
+        size_t next() const;
+
+        size_t index() const {
+            return index_;
+        }
+
+        int Bencode(std::ostream &os) const;
+
+        std::shared_ptr<BObject> to_object() const;
+
+        template<class T>
+        T value() const;
+
+    private:
+        uint64_t word() const;
+
+        const Tape *tape_{};
+        size_t index_{};
+    };
+
+    class TapeList {
+    public:
+        class iterator {
+        public:
+            iterator(const Tape *tape, size_t index) : tape_(tape), index_(index) {}
+
+            TapeRef operator*() const { return {tape_, index_}; }
+
+            iterator &operator++() {
+                index_ = TapeRef(tape_, index_).next();
+                return *this;
+            }
+
+            bool operator==(const iterator &o) const { return index_ == o.index_; }
+
+            bool operator!=(const iterator &o) const { return index_ != o.index_; }
+
+        private:
+            const Tape *tape_;
+            size_t index_;
+        };
+
+        TapeList() = default;
+
+        TapeList(const Tape *tape, size_t begin, size_t end, size_t size)
+                : tape_(tape), begin_(begin), end_(end), size_(size) {}
+
+        iterator begin() const { return {tape_, begin_}; }
+
+        iterator end() const { return {tape_, end_}; }
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        //linear,siblings are only reachable by skipping
+        TapeRef at(size_t index) const;
+
+    private:
+        const Tape *tape_{};
+        size_t begin_{};
+        size_t end_{};
+        size_t size_{};
+    };
+
+    class TapeDict {
+    public:
+        class iterator {
+        public:
+            iterator(const Tape *tape, size_t index) : tape_(tape), index_(index) {}
+
+            std::pair<std::string_view, TapeRef> operator*() const {
+                TapeRef key(tape_, index_);
+                return {key.Str(), TapeRef(tape_, key.next())};
+            }
+
+            iterator &operator++() {
+                index_ = TapeRef(tape_, TapeRef(tape_, index_).next()).next();
+                return *this;
+            }
+
+            bool operator==(const iterator &o) const { return index_ == o.index_; }
+
+            bool operator!=(const iterator &o) const { return index_ != o.index_; }
+
+        private:
+            const Tape *tape_;
+            size_t index_;
+        };
+
+        TapeDict() = default;
+
+        TapeDict(const Tape *tape, size_t begin, size_t end, size_t size)
+                : tape_(tape), begin_(begin), end_(end), size_(size) {}
+
+        iterator begin() const { return {tape_, begin_}; }
+
+        iterator end() const { return {tape_, end_}; }
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        //value of the first entry with this key,or end()
+        iterator find(std::string_view key) const;
+
+        size_t count(std::string_view key) const { return find(key) != end(); }
+
+    private:
+        const Tape *tape_{};
+        size_t begin_{};
+        size_t end_{};
+        size_t size_{};
+    };
+
+    //flat document:the whole tree is one uint64_t tape plus one string arena,
+    //so it is traversed linearly and copied or freed as two buffers
+    class Tape {
+    public:
+        Tape() = default;
+
+        static Tape Parse(std::string_view in, Error *error, size_t *consumed = nullptr,
+                          const ParseLimits &limits = {});
+
+        //ErrCnt if the tape would outgrow MaxWords
+        static Tape From(BObject &object, Error *error = nullptr);
+
+        //container entries keep the index of their end in 32 bits,so a tape holds at most this
+        //many words.parsing something bigger fails with ErrCnt
+        static constexpr size_t MaxWords = 0xFFFFFFFF;
+
+        //only meaningful when !empty(),a failed Parse returns an empty Tape
+        TapeRef root() const {
+            return {this, 0};
+        }
+
+        bool empty() const {
+            return tape_.empty();
+        }
+
+        //nullptr for an empty tape
+        std::shared_ptr<BObject> to_object() const {
+            if (empty()) {
+                return nullptr;
+            }
+            return root().to_object();
+        }
+
+        //nothing is written for an empty tape
+        int Bencode(std::ostream &os) const {
+            if (empty()) {
+                return 0;
+            }
+            return root().Bencode(os);
+        }
+
+        const std::vector<uint64_t> &words() const {
+            return tape_;
+        }
+
+        const std::string &strings() const {
+            return strings_;
+        }
+
+    private:
+        friend class TapeRef;
+
+        friend class StructuralIndex;
+
+        static constexpr uint64_t tagOf(char tag) {
+            return uint64_t(uint8_t(tag)) << 56;
+        }
+
+        static constexpr uint64_t PayloadMask = (uint64_t(1) << 56) - 1;
+
+        void appendString(std::string_view str);
+
+        void appendInt(int64_t val);
+
+        void appendBigInt(std::string_view digits);
+
+        size_t openContainer(char tag);
+
+        //false when the end index doesn't fit,the tape is then unusable
+        bool closeContainer(size_t start, size_t count);
+
+        bool appendObject(BObject &object);
+
+        std::vector<uint64_t> tape_;
+        std::string strings_;
+    };
+
+    template<class T>
+    T TapeRef::as(Error *error_code) const {
+        static_assert(std::is_integral_v<T>, "as<T>() converts to integer types only");
+        Error error;
+        auto val = Int(&error);
+        if (error == Error::ErrNum) {
+            return as_bigint().template as<T>(error_code);
+        }
+        if (error == Error::NoError && !std::in_range<T>(val)) {
+            error = Error::ErrNum;
+        }
+        if (error_code)*error_code = error;
+        return error == Error::NoError ? T(val) : 0;
+    }
+
+    template<class T>
+    T TapeRef::value() const {
+        Error error;
+        if constexpr(isInteger<T>::value) {
+            auto val = Int(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("TapeRef value() error,change to int failed!");
+            }
+            return T(val);
+        } else if constexpr(isString<T>::value || isStringView<T>::value) {
+            auto str = Str(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("TapeRef value() error,change to string failed!");
+            }
+            return T(str);
+        } else if constexpr(std::is_same_v<T, TapeList>) {
+            auto list = List(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("TapeRef value() error,change to List failed!");
+            }
+            return list;
+        } else if constexpr(std::is_same_v<T, TapeDict>) {
+            auto dict = Dict(&error);
+            if (error != Error::NoError) {
+                throw std::runtime_error("TapeRef value() error,change to Dict failed!");
+            }
+            return dict;
+        } else {
+            throw std::runtime_error("TapeRef value() error,no exist type");
+        }
+    }
+}
+
+#endif //TEST_BENCODE_TAPE_H
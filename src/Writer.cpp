@@ -0,0 +1,72 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#include "Writer.h"
+#include "BObject.h"
+#include <stdexcept>
+
+using bencode::Writer;
+
+Writer &bencode::Writer::value(BObject &object) {
+#ifndef NDEBUG
+    checkValue();
+#endif
+    object.encode_to(*out_);
+    return *this;
+}
+
+void bencode::Writer::checkValue() {
+    if (levels_.empty()) {
+        if (root_done_) {
+            throw std::runtime_error("Writer error,a second value after the root was finished!");
+        }
+        root_done_ = true;
+        return;
+    }
+    auto &top = levels_.back();
+    if (top.dict) {
+        if (!top.has_key) {
+            throw std::runtime_error("Writer error,dict value without a key!");
+        }
+        top.has_key = false;
+    }
+}
+
+void bencode::Writer::checkOpen(bool dict) {
+    checkValue();
+    //the root counts as finished only once its end() arrives
+    if (levels_.empty()) {
+        root_done_ = false;
+    }
+    levels_.push_back({dict, false, false, {}});
+}
+
+void bencode::Writer::checkKey(std::string_view k) {
+    if (levels_.empty() || !levels_.back().dict) {
+        throw std::runtime_error("Writer key() error,not inside a dict!");
+    }
+    auto &top = levels_.back();
+    if (top.has_key) {
+        throw std::runtime_error("Writer key() error,the previous key has no value!");
+    }
+    if (top.any_key && k <= std::string_view(top.last_key)) {
+        throw std::runtime_error("Writer key() error,keys must be unique and in ascending order!");
+    }
+    top.last_key.assign(k);
+    top.any_key = true;
+    top.has_key = true;
+}
+
+void bencode::Writer::checkEnd() {
+    if (levels_.empty()) {
+        throw std::runtime_error("Writer end() error,no open list or dict!");
+    }
+    if (levels_.back().has_key) {
+        throw std::runtime_error("Writer end() error,the last key has no value!");
+    }
+    levels_.pop_back();
+    if (levels_.empty()) {
+        root_done_ = true;
+    }
+}
@@ -0,0 +1,133 @@
+//
+// Created by Alone on 2026-10-17.
+//
+
+#ifndef TEST_BENCODE_WRITER_H
+#define TEST_BENCODE_WRITER_H
+
+#include "config.h"
+#include "type.h"
+#include "IntCodec.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bencode {
+    class BObject;
+
+    //encodes straight into a buffer,no tree is built:
+    //  Writer w;
+    //  w.begin_dict().key("ip").value(addr).key("port").value(6881).end();
+    //  send(w.str());
+    //keys must be given in ascending order.builds without NDEBUG check the nesting and the key
+    //order and throw std::runtime_error on a mistake,release builds only append bytes
+    class Writer {
+    public:
+        //writes into its own buffer,see str() and take()
+        Writer() : out_(&own_) {}
+
+        //appends to out,which must outlive the writer
+        explicit Writer(std::string &out) : out_(&out) {}
+
+        Writer(const Writer &) = delete;
+
+        Writer &operator=(const Writer &) = delete;
+
+        Writer &begin_dict() {
+#ifndef NDEBUG
+            checkOpen(true);
+#endif
+            out_->push_back('d');
+            return *this;
+        }
+
+        Writer &begin_list() {
+#ifndef NDEBUG
+            checkOpen(false);
+#endif
+            out_->push_back('l');
+            return *this;
+        }
+
+        Writer &key(std::string_view k) {
+#ifndef NDEBUG
+            checkKey(k);
+#endif
+            putString(k);
+            return *this;
+        }
+
+        Writer &value(int64_t v) {
+#ifndef NDEBUG
+            checkValue();
+#endif
+            char buf[22];
+            buf[0] = 'i';
+            auto len = 1 + FormatInt(buf + 1, v);
+            buf[len++] = 'e';
+            out_->append(buf, len);
+            return *this;
+        }
+
+        Writer &value(std::string_view v) {
+#ifndef NDEBUG
+            checkValue();
+#endif
+            putString(v);
+            return *this;
+        }
+
+        //an existing tree as one value
+        Writer &value(BObject &object);
+
+        //closes the innermost list or dict
+        Writer &end() {
+#ifndef NDEBUG
+            checkEnd();
+#endif
+            out_->push_back('e');
+            return *this;
+        }
+
+        const std::string &str() const {
+            return *out_;
+        }
+
+        std::string take() {
+            return std::move(*out_);
+        }
+
+    private:
+        void putString(std::string_view s) {
+            char buf[21];
+            auto len = FormatInt(buf, int64_t(s.size()));
+            buf[len++] = ':';
+            out_->append(buf, len);
+            out_->append(s);
+        }
+
+        //structure checks,only called when NDEBUG is not defined
+        void checkValue();
+
+        void checkOpen(bool dict);
+
+        void checkKey(std::string_view k);
+
+        void checkEnd();
+
+        struct Level {
+            bool dict;
+            bool has_key;//dict:a key is waiting for its value
+            bool any_key;
+            std::string last_key;
+        };
+
+        std::string own_;
+        std::string *out_;
+        std::vector<Level> levels_;
+        bool root_done_ = false;
+    };
+}
+
+#endif //TEST_BENCODE_WRITER_H
@@ -2,5 +2,15 @@
 
 #include "config.h"
 #include "type.h"
+#include "BigInt.h"
 #include "BObject.h"
-#include "BEntity.hpp"
\ No newline at end of file
+#include "BEntity.hpp"
+#include "Reader.h"
+#include "PushParser.h"
+#include "LazyValue.h"
+#include "Batch.h"
+#include "Writer.h"
+#include "Document.h"
+#include "Tape.h"
+#include "StructuralIndex.h"
+#include "Path.h"
@@ -8,9 +8,66 @@
 #ifdef U_DICT
 #define __DICT__  std::unordered_map
 #include <unordered_map>
+#elif defined(F_DICT)
+//sorted vector,keys stay in canonical order
+#define __DICT__  bencode::FlatMap
+#include "FlatMap.h"
 #else
 #define __DICT__  std::map
 #include <map>
 #endif
 
+#ifdef I_KEY
+//dict keys are interned,see Symbol.h
+#define __KEY__  bencode::Symbol
+#include "Symbol.h"
+#else
+#define __KEY__  std::string
+#include <string>
+#endif
+
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace bencode {
+    //hashes any key by its text.std::hash gives a string,a string_view and a Symbol of the same
+    //text the same value,so heterogeneous lookups land in the right bucket
+    struct KeyHash {
+        using is_transparent = void;
+
+        template<class K>
+        size_t operator()(const K &key) const noexcept {
+            if constexpr(std::is_same_v<K, __KEY__>) {
+                return std::hash<K>()(key);
+            } else {
+                return std::hash<std::string_view>()(key);
+            }
+        }
+    };
+
+    //a dict key read from parsed input.with I_KEY it may only take the input share of the
+    //symbol table,see SymbolTable::MaxInputSymbols
+    inline __KEY__ InputKey(std::string_view text) {
+#ifdef I_KEY
+        return Symbol::FromInput(text);
+#else
+        return __KEY__(text);
+#endif
+    }
+
+    //the dict inside a BObject.keys compare transparently,so find() takes a std::string_view or
+    //a literal as it is instead of building a key for it
+#ifdef U_DICT
+    template<class K, class V>
+    using NodeDict = std::unordered_map<K, V, KeyHash, std::equal_to<>>;
+#elif defined(F_DICT)
+    template<class K, class V>
+    using NodeDict = FlatMap<K, V>;
+#else
+    template<class K, class V>
+    using NodeDict = std::map<K, V, std::less<>>;
+#endif
+}
+
 #endif //TEST_BENCODE_CONFIG_H
@@ -27,6 +27,18 @@ void bencode::perror(bencode::Error error_code, const char *info) {
         case Error::ErrIvd:
             cerr << "invalid bencode\n";
             break;
+        case Error::ErrDep:
+            cerr << "nesting too deep\n";
+            break;
+        case Error::ErrCnt:
+            cerr << "too many nodes\n";
+            break;
+        case Error::ErrNfd:
+            cerr << "no such key or index\n";
+            break;
+        case Error::ErrSys:
+            cerr << "system call failed,see errno\n";
+            break;
         default:
             cerr << "no error\n";
     }
@@ -7,7 +7,9 @@
 
 #include "config.h"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
 
 namespace bencode {
     enum class Error {
@@ -17,6 +19,10 @@ namespace bencode {
         ErrEpE,
         ErrTyp,
         ErrIvd,
+        ErrDep,
+        ErrCnt,
+        ErrNfd,
+        ErrSys,
         NoError
     };
     enum class BType {
@@ -28,6 +34,12 @@ namespace bencode {
 
     void perror(Error error_code, const char *info = nullptr);
 
+    //guards against hostile input,exceeding a limit fails the parse with ErrDep/ErrCnt
+    struct ParseLimits {
+        size_t max_depth = 512;             //nesting of lists and dicts
+        size_t max_nodes = SIZE_MAX;        //values of any type,dict keys not counted
+    };
+
     // type trait
     template<class T>
     struct isString {
@@ -38,6 +50,14 @@ namespace bencode {
         static const bool value = true;
     };
     template<class T>
+    struct isStringView {
+        static const bool value = false;
+    };
+    template<>
+    struct isStringView<std::string_view> {
+        static const bool value = true;
+    };
+    template<class T>
     struct isInteger {
         static const bool value = false;
     };
@@ -45,6 +65,10 @@ namespace bencode {
     struct isInteger<int> {
         static const bool value = true;
     };
+    template<>
+    struct isInteger<int64_t> {
+        static const bool value = true;
+    };
 
     template<class T>
     struct isVector {
@@ -79,6 +103,10 @@ namespace bencode {
         static const bool value = true;
     };
     template<>
+    struct isBasicType<int64_t> {
+        static const bool value = true;
+    };
+    template<>
     struct isBasicType<std::string> {
         static const bool value = true;
     };